@@ -0,0 +1,125 @@
+#include "attacks.h"
+
+Magic rookMagics[64];
+Magic bishopMagics[64];
+#if defined(CHESS_USE_PEXT)
+const bool pextEnabled = true;
+#else
+const bool pextEnabled = false;
+#endif
+
+static Bitboard rookTable[0x19000];//룩 공격 표,모든 칸의 경우의 수 합계
+static Bitboard bishopTable[0x1480];//비숍 공격 표
+
+static Bitboard slidingAttacks(int square, Bitboard occupied, const int directions[4][2])
+//표를 만들때만 쓰는 느린 계산,한칸씩 진행하며 막히면 멈춤
+{
+    Bitboard attacks = 0;
+    for (int d = 0; d < 4; ++d)
+    {
+        int file = fileOf(square) + directions[d][0];
+        int rank = rankOf(square) + directions[d][1];
+        while (file >= 0 && file < 8 && rank >= 0 && rank < 8)
+        {
+            Bitboard bit = squareBit(makeSquare(file, rank));
+            attacks |= bit;
+            if (occupied & bit)
+            {
+                break;
+            }
+            file += directions[d][0];
+            rank += directions[d][1];
+        }
+    }
+    return attacks;
+}
+
+static Bitboard randomSparse(uint64_t& seed)//비트가 적은 난수,매직 후보로 사용
+{
+    Bitboard r = ~Bitboard(0);
+    for (int i = 0; i < 3; ++i)
+    {
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        r &= seed * 2685821657736338717ULL;
+    }
+    return r;
+}
+
+static void initMagics(Bitboard table[], Magic magics[], const int directions[4][2])
+{
+    static const uint64_t seeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+    //랭크별 난수 시드,매직을 빨리 찾도록 고른 값
+
+    Bitboard occupancy[4096];
+    Bitboard reference[4096];
+    int epoch[4096] = {};
+    int count = 0;
+    int size = 0;
+
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        Bitboard edges = ((Bitboard(0xFF) | (Bitboard(0xFF) << 56)) & ~(Bitboard(0xFF) << (8 * rankOf(sq))))
+                         | ((Bitboard(0x0101010101010101) | (Bitboard(0x0101010101010101) << 7))
+                            & ~(Bitboard(0x0101010101010101) << fileOf(sq)));
+        //가장자리 칸은 막혀도 결과가 같으므로 마스크에서 제외
+
+        Magic& m = magics[sq];
+        m.mask = slidingAttacks(sq, 0, directions) & ~edges;
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = sq == 0 ? table : magics[sq - 1].attacks + size;
+
+        size = 0;
+        Bitboard b = 0;
+        do
+        {//마스크의 모든 부분집합을 차례로 만듦
+            occupancy[size] = b;
+            reference[size] = slidingAttacks(sq, b, directions);
+            if (pextEnabled)
+            {
+                m.attacks[m.index(b)] = reference[size];
+            }
+            ++size;
+            b = (b - m.mask) & m.mask;
+        } while (b);
+
+        if (pextEnabled)
+        {
+            continue;//PEXT는 충돌이 없으므로 매직을 찾을 필요가 없음
+        }
+
+        uint64_t seed = seeds[rankOf(sq)];
+        for (int i = 0; i < size;)
+        {//모든 부분집합이 충돌없이 들어가는 매직을 찾을때까지 반복
+            for (m.magic = 0; popCount((m.magic * m.mask) >> 56) < 6;)
+            {
+                m.magic = randomSparse(seed);
+            }
+
+            ++count;
+            for (i = 0; i < size; ++i)
+            {
+                unsigned idx = m.index(occupancy[i]);
+                if (epoch[idx] < count)
+                {
+                    epoch[idx] = count;
+                    m.attacks[idx] = reference[i];
+                }
+                else if (m.attacks[idx] != reference[i])
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void initAttacks()
+{
+    static const int rookDirections[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    static const int bishopDirections[4][2] = { { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+    initMagics(rookTable, rookMagics, rookDirections);
+    initMagics(bishopTable, bishopMagics, bishopDirections);
+}
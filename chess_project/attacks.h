@@ -0,0 +1,57 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "bitboard.h"
+
+#if defined(CHESS_USE_PEXT)
+#include <immintrin.h>
+#endif
+
+//룩,비숍,퀸의 공격 범위를 미리 계산된 표에서 한번에 찾는 모듈
+//기본은 매직 곱셈 인덱스이고,CMake의 CHESS_PEXT를 켜면 chess_core만 CHESS_USE_PEXT로 빌드되어 PEXT 인덱스를 사용한다
+//인덱스 방식은 빌드할때 정해지므로 조회마다 분기하거나 함수를 호출하지 않음
+//표의 배치가 인덱스 방식을 따르므로 아래 조회 함수는 chess_core 안에서만 호출하고,밖에서는 initAttacks와 pextEnabled만 사용
+
+struct Magic
+{
+    Bitboard mask;//가장자리를 제외한 이동 경로 칸
+    Bitboard magic;//매직 곱셈 상수,PEXT 사용시에는 쓰지 않음
+    Bitboard* attacks;//이 칸의 공격 표 시작 위치
+    unsigned shift;
+
+    unsigned index(Bitboard occupied) const;
+};
+
+extern Magic rookMagics[64];
+extern Magic bishopMagics[64];
+extern const bool pextEnabled;//chess_core가 BMI2 PEXT로 빌드되었는지 여부
+
+void initAttacks();//프로그램 시작시 한번 호출해야 함
+
+inline unsigned Magic::index(Bitboard occupied) const
+{
+#if defined(CHESS_USE_PEXT)
+    return unsigned(_pext_u64(occupied, mask));
+#else
+    return unsigned(((occupied & mask) * magic) >> shift);
+#endif
+}
+
+inline Bitboard rookAttacks(int square, Bitboard occupied)
+{
+    const Magic& m = rookMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard bishopAttacks(int square, Bitboard occupied)
+{
+    const Magic& m = bishopMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard queenAttacks(int square, Bitboard occupied)
+{
+    return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
+
+#endif // ATTACKS_H
@@ -0,0 +1,72 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+//비트보드 기본 타입과 비트 연산 도우미
+//칸 번호는 a1=0, b1=1, ... h8=63 순서
+
+using Bitboard = uint64_t;
+
+constexpr Bitboard FileABB = 0x0101010101010101ULL;
+constexpr Bitboard FileHBB = FileABB << 7;
+constexpr Bitboard Rank1BB = 0xFFULL;
+constexpr Bitboard Rank8BB = Rank1BB << 56;
+
+constexpr int makeSquare(int file, int rank)
+{
+    return rank * 8 + file;
+}
+
+constexpr int fileOf(int square)
+{
+    return square & 7;
+}
+
+constexpr int rankOf(int square)
+{
+    return square >> 3;
+}
+
+constexpr Bitboard squareBit(int square)
+{
+    return Bitboard(1) << square;
+}
+
+constexpr int popCount(Bitboard b)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(b);
+#else
+    int count = 0;
+    for (; b; b &= b - 1)
+    {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+constexpr int lsb(Bitboard b)//가장 낮은 비트의 칸 번호,b는 0이 아니어야 함
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(b);
+#else
+    int square = 0;
+    while (!(b & 1))
+    {
+        b >>= 1;
+        ++square;
+    }
+    return square;
+#endif
+}
+
+inline int popLsb(Bitboard& b)//가장 낮은 비트를 꺼내고 지움
+{
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+#endif // BITBOARD_H
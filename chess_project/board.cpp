@@ -0,0 +1,850 @@
+#include "board.h"
+#include "attacks.h"
+#include "tables.h"
+#include "zobrist.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+static const char pieceChars[] = "PNBRQKpnbrqk";//FEN 기물 문자,Piece 순서와 같음
+
+static const int SeeKingValue = 10000;//지켜지는 기물을 킹으로 잡는 수의 교환 점수
+
+static int castlingMask(int square)
+//해당 칸에서 기물이 움직이거나 잡히면 유지되는 캐슬링 권리
+{
+    switch (square)
+    {
+    case 0:
+        return ~WhiteQueenSide;//a1 룩
+    case 7:
+        return ~WhiteKingSide;//h1 룩
+    case 4:
+        return ~(WhiteKingSide | WhiteQueenSide);//e1 킹
+    case 56:
+        return ~BlackQueenSide;//a8 룩
+    case 63:
+        return ~BlackKingSide;//h8 룩
+    case 60:
+        return ~(BlackKingSide | BlackQueenSide);//e8 킹
+    default:
+        return ~0;
+    }
+}
+
+Board::Board()
+{
+    clear();
+}
+
+void Board::clear()
+{
+    for (int i = 0; i < 12; ++i)
+    {
+        pieceBB[i] = 0;
+    }
+    colorBB[White] = 0;
+    colorBB[Black] = 0;
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        mailbox[sq] = NoPiece;
+    }
+    side = White;
+    castling = 0;
+    enPassant = NoSquare;
+    halfmoves = 0;
+    fullmoves = 1;
+    positionKey = 0;
+    pawnHashKey = 0;
+    psq = Score{ 0, 0 };
+    phase = 0;
+    pliesFromNull = 0;
+    stateCount = 0;
+}
+
+void Board::setStartPosition()
+{
+    static const PieceType backRank[8] = { Rook, Knight, Bishop, Queen, King, Bishop, Knight, Rook };
+    //1랭크와 8랭크의 기물 순서
+
+    clear();
+    for (int file = 0; file < 8; ++file)
+    {
+        putPiece(makePiece(White, backRank[file]), makeSquare(file, 0));
+        putPiece(WhitePawn, makeSquare(file, 1));
+        putPiece(BlackPawn, makeSquare(file, 6));
+        putPiece(makePiece(Black, backRank[file]), makeSquare(file, 7));
+    }
+    castling = WhiteKingSide | WhiteQueenSide | BlackKingSide | BlackQueenSide;
+    positionKey = computeKey();
+}
+
+bool Board::setFen(const std::string& fen)
+{
+    std::istringstream in(fen);
+    std::string placement, color, rights, ep;
+    if (!(in >> placement >> color >> rights >> ep))
+    {
+        return false;
+    }
+
+    clear();
+    int file = 0;
+    int rank = 7;//FEN은 8랭크부터 시작
+    for (char c : placement)
+    {
+        if (c == '/')
+        {
+            file = 0;
+            --rank;
+        }
+        else if (c >= '1' && c <= '8')
+        {
+            file += c - '0';
+        }
+        else
+        {
+            const char* found = nullptr;
+            for (const char* p = pieceChars; *p; ++p)
+            {
+                if (*p == c)
+                {
+                    found = p;
+                }
+            }
+            if (!found || file > 7 || rank < 0)
+            {
+                clear();
+                return false;
+            }
+            putPiece(Piece(found - pieceChars), makeSquare(file, rank));
+            ++file;
+        }
+    }
+    if (popCount(pieces(White, King)) != 1 || popCount(pieces(Black, King)) != 1)
+    {//킹이 한개씩 있어야 규칙 계산이 가능
+        clear();
+        return false;
+    }
+
+    side = color == "b" ? Black : White;
+
+    for (char c : rights)
+    {
+        if (c == 'K') castling |= WhiteKingSide;
+        if (c == 'Q') castling |= WhiteQueenSide;
+        if (c == 'k') castling |= BlackKingSide;
+        if (c == 'q') castling |= BlackQueenSide;
+    }
+
+    if (ep.size() == 2 && ep[0] >= 'a' && ep[0] <= 'h' && ep[1] >= '1' && ep[1] <= '8')
+    {
+        enPassant = makeSquare(ep[0] - 'a', ep[1] - '1');
+    }
+
+    if (!isValidPosition())
+    {//수 생성이 가정하는 조건을 어기는 국면은 받지 않음
+        clear();
+        return false;
+    }
+
+    int halfmoveValue = 0;
+    int fullmoveValue = 1;
+    if (in >> halfmoveValue >> fullmoveValue)
+    {//두 숫자는 생략될 수 있음
+        halfmoves = halfmoveValue;
+        fullmoves = fullmoveValue;
+    }
+    positionKey = computeKey();
+    return true;
+}
+
+std::string Board::fen() const
+{
+    std::string result;
+    for (int rank = 7; rank >= 0; --rank)
+    {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file)
+        {
+            Piece piece = mailbox[makeSquare(file, rank)];
+            if (piece == NoPiece)
+            {
+                ++empty;
+                continue;
+            }
+            if (empty)
+            {
+                result += char('0' + empty);
+                empty = 0;
+            }
+            result += pieceChars[piece];
+        }
+        if (empty)
+        {
+            result += char('0' + empty);
+        }
+        if (rank > 0)
+        {
+            result += '/';
+        }
+    }
+
+    result += side == White ? " w " : " b ";
+    if (castling & WhiteKingSide) result += 'K';
+    if (castling & WhiteQueenSide) result += 'Q';
+    if (castling & BlackKingSide) result += 'k';
+    if (castling & BlackQueenSide) result += 'q';
+    if (!castling) result += '-';
+
+    if (enPassant == NoSquare)
+    {
+        result += " -";
+    }
+    else
+    {
+        result += ' ';
+        result += char('a' + fileOf(enPassant));
+        result += char('1' + rankOf(enPassant));
+    }
+    result += ' ' + std::to_string(halfmoves) + ' ' + std::to_string(fullmoves);
+    return result;
+}
+
+uint64_t Board::computeKey() const
+{
+    uint64_t key = 0;
+    for (Bitboard b = occupied(); b;)
+    {
+        int sq = popLsb(b);
+        key ^= Zobrist.pieceSquare[mailbox[sq]][sq];
+    }
+    if (side == Black)
+    {
+        key ^= Zobrist.side;
+    }
+    key ^= Zobrist.castling[castling];
+    if (enPassant != NoSquare)
+    {
+        key ^= Zobrist.enPassant[fileOf(enPassant)];
+    }
+    return key;
+}
+
+int Board::repetitions() const
+{
+    int count = 0;
+    int last = halfmoves < pliesFromNull ? halfmoves : pliesFromNull;
+    //폰 이동이나 잡기 이전의 국면은 다시 나올 수 없음
+    for (int back = 4; back <= last; back += 2)
+    {//같은 쪽 차례인 국면만 비교
+        if (states[stateCount - back].key == positionKey)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+Bitboard Board::attackersTo(int square, Bitboard occupied) const
+{
+    return (PawnAttacks[Black][square] & pieceBB[WhitePawn])
+           | (PawnAttacks[White][square] & pieceBB[BlackPawn])
+           | (KnightAttacks[square] & pieces(Knight))
+           | (KingAttacks[square] & pieces(King))
+           | (rookAttacks(square, occupied) & (pieces(Rook) | pieces(Queen)))
+           | (bishopAttacks(square, occupied) & (pieces(Bishop) | pieces(Queen)));
+    //칸에서 각 기물처럼 공격해보고 닿는 상대 기물을 모음
+}
+
+Bitboard Board::checkers() const
+{
+    return attackersTo(kingSquare(side), occupied()) & colorBB[side ^ 1];
+}
+
+Bitboard Board::pinned(Color color) const
+{
+    Color them = Color(color ^ 1);
+    int kingSq = kingSquare(color);
+    Bitboard theirs = colorBB[them];
+    Bitboard snipers = (rookAttacks(kingSq, theirs) & (pieces(them, Rook) | pieces(them, Queen)))
+                     | (bishopAttacks(kingSq, theirs) & (pieces(them, Bishop) | pieces(them, Queen)));
+    Bitboard result = 0;
+    while (snipers)
+    {
+        Bitboard blockers = BetweenBB[kingSq][popLsb(snipers)] & occupied();
+        if (popCount(blockers) == 1 && (blockers & colorBB[color]))
+        {
+            result |= blockers;
+        }
+    }
+    return result;
+}
+
+bool Board::pseudoLegal(const Move& move) const
+{
+    int from = move.from();
+    int to = move.to();
+    Piece piece = mailbox[from];
+    MoveFlag flag = move.moveFlag();
+    if (move.isNone() || piece == NoPiece || colorOf(piece) != side || (colorBB[side] & squareBit(to)))
+    {
+        return false;
+    }
+    if (flag != PromotionMove && move.promotionType() != Knight)
+    {
+        return false;//수 생성기는 프로모션이 아닌 수의 프로모션 비트를 비워둠
+    }
+
+    PieceType type = typeOf(piece);
+    Bitboard occupiedBB = occupied();
+    if (flag == CastlingMove)
+    {//권리가 있고 룩이 제자리에 있으며 킹과 룩 사이가 비어 있어야 함
+        int base = side == White ? 0 : 56;
+        if (type != King || from != base + 4 || (to != base + 6 && to != base + 2))
+        {
+            return false;
+        }
+        bool kingSide = to == base + 6;
+        int right = side == White ? (kingSide ? WhiteKingSide : WhiteQueenSide)
+                                  : (kingSide ? BlackKingSide : BlackQueenSide);
+        int rookSquare = kingSide ? base + 7 : base;
+        return (castling & right) && mailbox[rookSquare] == makePiece(side, Rook)
+               && !(BetweenBB[from][rookSquare] & occupiedBB);
+    }
+    if (flag == EnPassantMove)
+    {
+        return type == Pawn && to == enPassant && (PawnAttacks[side][from] & squareBit(to));
+    }
+
+    if (type == Pawn)
+    {
+        bool lastRank = rankOf(to) == (side == White ? 7 : 0);
+        if (lastRank != (flag == PromotionMove))
+        {
+            return false;
+        }
+        int up = side == White ? 8 : -8;
+        if (PawnAttacks[side][from] & colorBB[side ^ 1] & squareBit(to))
+        {
+            return true;
+        }
+        if (to == from + up)
+        {
+            return mailbox[to] == NoPiece;
+        }
+        return to == from + 2 * up && rankOf(from) == (side == White ? 1 : 6)
+               && mailbox[from + up] == NoPiece && mailbox[to] == NoPiece;
+    }
+    if (flag != NormalMove)
+    {
+        return false;
+    }
+
+    Bitboard attacks = 0;
+    switch (type)
+    {
+    case Knight: attacks = KnightAttacks[from]; break;
+    case Bishop: attacks = bishopAttacks(from, occupiedBB); break;
+    case Rook: attacks = rookAttacks(from, occupiedBB); break;
+    case Queen: attacks = queenAttacks(from, occupiedBB); break;
+    default: attacks = KingAttacks[from]; break;
+    }
+    return (attacks & squareBit(to)) != 0;
+}
+
+bool Board::legal(const Move& move) const
+{
+    int from = move.from();
+    int to = move.to();
+    Bitboard theirs = colorBB[side ^ 1];
+    Bitboard occupiedBB = occupied();
+    int kingSq = kingSquare(side);
+
+    if (move.moveFlag() == CastlingMove)
+    {//체크 중이 아니고 킹이 지나가는 칸과 도착칸이 공격받지 않아야 함
+        int step = to > from ? 1 : -1;
+        for (int sq = from; sq != to + step; sq += step)
+        {
+            if (attackersTo(sq, occupiedBB) & theirs)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (from == kingSq)
+    {//킹을 뺀 점유 상태로 봐야 슬라이딩 기물 반대편으로 피하는 수를 막을 수 있음
+        return !(attackersTo(to, occupiedBB ^ squareBit(from)) & theirs);
+    }
+    if (move.moveFlag() == EnPassantMove)
+    {//두 폰이 한꺼번에 사라지므로 이동 후 점유 상태로 직접 검사
+        int capturedSq = side == White ? to - 8 : to + 8;
+        Bitboard after = (occupiedBB ^ squareBit(from) ^ squareBit(capturedSq)) | squareBit(to);
+        return !(attackersTo(kingSq, after) & theirs & ~squareBit(capturedSq));
+    }
+
+    Bitboard checkersBB = attackersTo(kingSq, occupiedBB) & theirs;
+    if (checkersBB)
+    {//이중 체크는 킹만 움직일 수 있고,아니면 체크를 건 기물을 잡거나 사이를 막아야 함
+        if (popCount(checkersBB) > 1 || !((BetweenBB[kingSq][lsb(checkersBB)] | checkersBB) & squareBit(to)))
+        {
+            return false;
+        }
+    }
+    return !(pinned(side) & squareBit(from)) || aligned(kingSq, from, to);
+}
+
+bool Board::isValidPosition() const
+{
+    if (pieces(Pawn) & (Rank1BB | Rank8BB))
+    {
+        return false;//폰은 1랭크나 8랭크에 있을 수 없음
+    }
+
+    //캐슬링 권리가 있으면 킹과 룩이 처음 자리에 있어야 함
+    if ((castling & (WhiteKingSide | WhiteQueenSide)) && mailbox[4] != WhiteKing)
+    {
+        return false;
+    }
+    if ((castling & (BlackKingSide | BlackQueenSide)) && mailbox[60] != BlackKing)
+    {
+        return false;
+    }
+    if (((castling & WhiteKingSide) && mailbox[7] != WhiteRook)
+        || ((castling & WhiteQueenSide) && mailbox[0] != WhiteRook)
+        || ((castling & BlackKingSide) && mailbox[63] != BlackRook)
+        || ((castling & BlackQueenSide) && mailbox[56] != BlackRook))
+    {
+        return false;
+    }
+
+    if (enPassant != NoSquare)
+    {//앙파상 칸은 방금 두칸 전진한 상대 폰의 바로 뒤,폰이 지나온 두 칸은 비어 있어야 함
+        int pawnSquare = side == White ? enPassant - 8 : enPassant + 8;
+        int startSquare = side == White ? enPassant + 8 : enPassant - 8;
+        if (rankOf(enPassant) != (side == White ? 5 : 2)
+            || mailbox[pawnSquare] != makePiece(Color(side ^ 1), Pawn)
+            || mailbox[enPassant] != NoPiece || mailbox[startSquare] != NoPiece)
+        {
+            return false;
+        }
+    }
+
+    Color them = Color(side ^ 1);
+    if (attackersTo(kingSquare(them), occupied()) & colorBB[side])
+    {
+        return false;//두지 않는 쪽이 체크 상태면 킹을 잡을 수 있게 됨
+    }
+    return true;
+}
+
+int Board::see(const Move& move) const
+{
+    if (move.moveFlag() == CastlingMove)
+    {
+        return 0;
+    }
+
+    int from = move.from();
+    int to = move.to();
+    Color stm = colorOf(mailbox[from]);
+    Bitboard occ = occupied() ^ squareBit(from);
+    int gain[32];
+    int depth = 0;
+    int attackerValue = PieceValue[typeOf(mailbox[from])];
+
+    if (typeOf(mailbox[from]) == King && (attackersTo(to, occ) & colorBB[stm ^ 1]))
+    {
+        return -SeeKingValue;//지켜지는 칸은 킹으로 잡을 수 없음,어떤 교환보다 나쁜 수로 평가
+    }
+
+    if (move.moveFlag() == EnPassantMove)
+    {
+        gain[0] = PieceValue[Pawn];
+        occ ^= squareBit(stm == White ? to - 8 : to + 8);
+    }
+    else
+    {
+        gain[0] = PieceValue[typeOf(mailbox[to])];
+    }
+    if (move.moveFlag() == PromotionMove)
+    {
+        gain[0] += PieceValue[move.promotionType()] - PieceValue[Pawn];
+        attackerValue = PieceValue[move.promotionType()];
+    }
+
+    Bitboard attackers = attackersTo(to, occ) & occ;
+    Bitboard bishops = pieces(Bishop) | pieces(Queen);
+    Bitboard rooks = pieces(Rook) | pieces(Queen);
+
+    while (depth < 31)
+    {
+        stm = Color(stm ^ 1);
+        Bitboard stmAttackers = attackers & colorBB[stm];
+        if (!stmAttackers)
+        {
+            break;
+        }
+        int type = Pawn;
+        while (!(stmAttackers & pieces(PieceType(type))))
+        {//가장 싼 공격 기물
+            ++type;
+        }
+        if (type == King && (attackers & colorBB[stm ^ 1]))
+        {
+            break;//지켜지는 칸은 킹으로 잡을 수 없음
+        }
+
+        ++depth;
+        gain[depth] = attackerValue - gain[depth - 1];//이번에 잡는 쪽이 지금까지 얻은 점수
+        attackerValue = PieceValue[type];
+
+        occ ^= squareBit(lsb(stmAttackers & pieces(PieceType(type))));
+        if (type == Pawn || type == Bishop || type == Queen)
+        {
+            attackers |= bishopAttacks(to, occ) & bishops;
+        }
+        if (type == Rook || type == Queen)
+        {
+            attackers |= rookAttacks(to, occ) & rooks;
+        }
+        attackers &= occ;
+    }
+
+    while (depth > 0)
+    {//각 단계에서 잡지 않고 멈추는 쪽이 유리하면 멈춤
+        gain[depth - 1] = -(-gain[depth - 1] > gain[depth] ? -gain[depth - 1] : gain[depth]);
+        --depth;
+    }
+    return gain[0];
+}
+
+bool Board::seeGe(const Move& move, int threshold) const
+{
+    if (move.moveFlag() != NormalMove)
+    {//드문 수는 전체 교환 계산으로 판정
+        return see(move) >= threshold;
+    }
+
+    int from = move.from();
+    int to = move.to();
+    int swap = PieceValue[typeOf(mailbox[to])] - threshold;
+    if (swap < 0)
+    {
+        return false;//잡은 기물만으로도 부족
+    }
+    if (typeOf(mailbox[from]) == King)
+    {//킹은 상대가 다시 잡을 수 없는 칸의 기물만 잡을 수 있음
+        return !(attackersTo(to, occupied() ^ squareBit(from)) & colorBB[colorOf(mailbox[from]) ^ 1]);
+    }
+    swap = PieceValue[typeOf(mailbox[from])] - swap;
+    if (swap <= 0)
+    {
+        return true;//잡은 기물을 바로 잃어도 충분
+    }
+
+    Bitboard occ = occupied() ^ squareBit(from) ^ squareBit(to);
+    Bitboard attackers = attackersTo(to, occ);
+    Bitboard bishops = pieces(Bishop) | pieces(Queen);
+    Bitboard rooks = pieces(Rook) | pieces(Queen);
+    Color stm = colorOf(mailbox[from]);
+    bool result = true;
+
+    while (true)
+    {
+        stm = Color(stm ^ 1);
+        attackers &= occ;
+        Bitboard stmAttackers = attackers & colorBB[stm];
+        if (!stmAttackers)
+        {
+            break;
+        }
+        result = !result;
+
+        //가장 싼 기물로 잡고,그 뒤에 숨어있던 슬라이딩 기물을 공격자에 추가
+        Bitboard b;
+        if ((b = stmAttackers & pieces(Pawn)))
+        {
+            if ((swap = PieceValue[Pawn] - swap) < int(result))
+            {
+                break;
+            }
+            occ ^= squareBit(lsb(b));
+            attackers |= bishopAttacks(to, occ) & bishops;
+        }
+        else if ((b = stmAttackers & pieces(Knight)))
+        {
+            if ((swap = PieceValue[Knight] - swap) < int(result))
+            {
+                break;
+            }
+            occ ^= squareBit(lsb(b));
+        }
+        else if ((b = stmAttackers & pieces(Bishop)))
+        {
+            if ((swap = PieceValue[Bishop] - swap) < int(result))
+            {
+                break;
+            }
+            occ ^= squareBit(lsb(b));
+            attackers |= bishopAttacks(to, occ) & bishops;
+        }
+        else if ((b = stmAttackers & pieces(Rook)))
+        {
+            if ((swap = PieceValue[Rook] - swap) < int(result))
+            {
+                break;
+            }
+            occ ^= squareBit(lsb(b));
+            attackers |= rookAttacks(to, occ) & rooks;
+        }
+        else if ((b = stmAttackers & pieces(Queen)))
+        {
+            if ((swap = PieceValue[Queen] - swap) < int(result))
+            {
+                break;
+            }
+            occ ^= squareBit(lsb(b));
+            attackers |= (bishopAttacks(to, occ) & bishops) | (rookAttacks(to, occ) & rooks);
+        }
+        else
+        {//킹으로 잡을때 상대 공격자가 남아있으면 잡을 수 없음
+            return (attackers & ~colorBB[stm]) ? !result : result;
+        }
+    }
+    return result;
+}
+
+void Board::putPiece(Piece piece, int square)
+{
+    Bitboard bit = squareBit(square);
+    pieceBB[piece] |= bit;
+    colorBB[colorOf(piece)] |= bit;
+    mailbox[square] = piece;
+    positionKey ^= Zobrist.pieceSquare[piece][square];
+    if (typeOf(piece) == Pawn)
+    {
+        pawnHashKey ^= Zobrist.pieceSquare[piece][square];
+    }
+    psq += PsqTable[piece][square];
+    phase += PhaseWeight[typeOf(piece)];
+}
+
+void Board::removePiece(int square)
+{
+    Piece piece = mailbox[square];
+    if (piece == NoPiece)
+    {
+        return;
+    }
+    Bitboard bit = squareBit(square);
+    pieceBB[piece] &= ~bit;
+    colorBB[colorOf(piece)] &= ~bit;
+    mailbox[square] = NoPiece;
+    positionKey ^= Zobrist.pieceSquare[piece][square];
+    if (typeOf(piece) == Pawn)
+    {
+        pawnHashKey ^= Zobrist.pieceSquare[piece][square];
+    }
+    psq -= PsqTable[piece][square];
+    phase -= PhaseWeight[typeOf(piece)];
+}
+
+void Board::movePiece(int from, int to)
+{
+    if (from == to)
+    {
+        return;
+    }
+    Piece piece = mailbox[from];
+    removePiece(to);//잡힌 기물 제거
+    removePiece(from);
+    putPiece(piece, to);
+}
+
+bool Board::editMove(int from, int to)
+{
+    std::string previous = fen();
+    movePiece(from, to);
+
+    //킹이나 룩이 처음 자리를 떠나면 해당 캐슬링 권리가 사라짐
+    if (mailbox[4] != WhiteKing || mailbox[7] != WhiteRook) castling &= ~WhiteKingSide;
+    if (mailbox[4] != WhiteKing || mailbox[0] != WhiteRook) castling &= ~WhiteQueenSide;
+    if (mailbox[60] != BlackKing || mailbox[63] != BlackRook) castling &= ~BlackKingSide;
+    if (mailbox[60] != BlackKing || mailbox[56] != BlackRook) castling &= ~BlackQueenSide;
+    enPassant = NoSquare;//직전 수가 두칸 전진이 아니게 됨
+
+    if (!setFen(fen()))
+    {//키와 상태 스택도 새 국면 기준으로 다시 계산됨
+        setFen(previous);
+        return false;
+    }
+    return true;
+}
+
+static void checkStateStack(int stateCount)
+//게임은 MaxGamePly,탐색은 MaxSearchPly를 넘지 않음
+//넘치면 states 뒤의 메모리를 덮어쓰므로 릴리스 빌드에서도 즉시 중단
+{
+    if (stateCount >= MaxGamePly + MaxSearchPly)
+    {
+        std::fprintf(stderr, "board state stack overflow (%d plies)\n", stateCount);
+        std::abort();
+    }
+}
+
+void Board::makeMove(const Move& move)
+{
+    int from = move.from();
+    int to = move.to();
+    Color us = side;
+    Color them = Color(us ^ 1);
+    Piece piece = mailbox[from];
+
+    checkStateStack(stateCount);
+    StateInfo& saved = states[stateCount++];//현재 상태를 스택에 저장
+    saved.key = positionKey;
+    saved.castling = uint8_t(castling);
+    saved.enPassant = uint8_t(enPassant);
+    saved.halfmoves = uint16_t(halfmoves);
+    saved.pliesFromNull = uint16_t(pliesFromNull);
+    saved.captured = NoPiece;
+
+    positionKey ^= Zobrist.castling[castling];
+    if (enPassant != NoSquare)
+    {
+        positionKey ^= Zobrist.enPassant[fileOf(enPassant)];
+    }
+
+    if (move.moveFlag() == CastlingMove)
+    {//킹이 두칸 이동하고 룩이 킹을 넘어 옆칸으로 이동
+        bool kingSide = to > from;
+        movePiece(from, to);
+        movePiece(kingSide ? from + 3 : from - 4, kingSide ? from + 1 : from - 1);
+    }
+    else if (move.moveFlag() == EnPassantMove)
+    {//잡히는 폰은 도착칸 뒤에 있음
+        int capturedSq = us == White ? to - 8 : to + 8;
+        saved.captured = mailbox[capturedSq];
+        removePiece(capturedSq);
+        movePiece(from, to);
+    }
+    else
+    {
+        saved.captured = mailbox[to];
+        removePiece(to);
+        movePiece(from, to);
+        if (move.moveFlag() == PromotionMove)
+        {
+            removePiece(to);
+            putPiece(makePiece(us, move.promotionType()), to);
+        }
+    }
+
+    castling &= castlingMask(from) & castlingMask(to);
+    positionKey ^= Zobrist.castling[castling];
+
+    enPassant = NoSquare;
+    if (typeOf(piece) == Pawn && (to ^ from) == 16)
+    {//두칸 전진했고 상대 폰이 지나간 칸을 공격할 수 있을때만 앙파상 칸 설정
+        int passed = (from + to) / 2;
+        if (PawnAttacks[us][passed] & pieceBB[makePiece(them, Pawn)])
+        {
+            enPassant = passed;
+            positionKey ^= Zobrist.enPassant[fileOf(passed)];
+        }
+    }
+
+    if (typeOf(piece) == Pawn || saved.captured != NoPiece)
+    {
+        halfmoves = 0;
+    }
+    else
+    {
+        ++halfmoves;
+    }
+    if (us == Black)
+    {
+        ++fullmoves;
+    }
+    ++pliesFromNull;
+    side = them;
+    positionKey ^= Zobrist.side;
+}
+
+void Board::unmakeMove(const Move& move)
+{
+    int from = move.from();
+    int to = move.to();
+    side = Color(side ^ 1);
+    Color us = side;
+    if (us == Black)
+    {
+        --fullmoves;
+    }
+    const StateInfo& saved = states[--stateCount];
+
+    if (move.moveFlag() == CastlingMove)
+    {
+        bool kingSide = to > from;
+        movePiece(to, from);
+        movePiece(kingSide ? from + 1 : from - 1, kingSide ? from + 3 : from - 4);
+    }
+    else if (move.moveFlag() == EnPassantMove)
+    {
+        movePiece(to, from);
+        putPiece(saved.captured, us == White ? to - 8 : to + 8);
+    }
+    else
+    {
+        if (move.moveFlag() == PromotionMove)
+        {//프로모션된 기물을 다시 폰으로
+            removePiece(to);
+            putPiece(makePiece(us, Pawn), to);
+        }
+        movePiece(to, from);
+        if (saved.captured != NoPiece)
+        {
+            putPiece(saved.captured, to);
+        }
+    }
+
+    castling = saved.castling;
+    enPassant = saved.enPassant;
+    halfmoves = saved.halfmoves;
+    pliesFromNull = saved.pliesFromNull;
+    positionKey = saved.key;//기물 이동중 바뀐 키는 저장된 값으로 덮어씀
+}
+
+void Board::makeNullMove()
+{
+    checkStateStack(stateCount);
+    StateInfo& saved = states[stateCount++];
+    saved.key = positionKey;
+    saved.castling = uint8_t(castling);
+    saved.enPassant = uint8_t(enPassant);
+    saved.halfmoves = uint16_t(halfmoves);
+    saved.pliesFromNull = uint16_t(pliesFromNull);
+    saved.captured = NoPiece;
+
+    if (enPassant != NoSquare)
+    {
+        positionKey ^= Zobrist.enPassant[fileOf(enPassant)];
+        enPassant = NoSquare;
+    }
+    ++halfmoves;
+    pliesFromNull = 0;
+    side = Color(side ^ 1);
+    positionKey ^= Zobrist.side;
+}
+
+void Board::unmakeNullMove()
+{
+    const StateInfo& saved = states[--stateCount];
+    side = Color(side ^ 1);
+    enPassant = saved.enPassant;
+    halfmoves = saved.halfmoves;
+    pliesFromNull = saved.pliesFromNull;
+    positionKey = saved.key;
+}
@@ -0,0 +1,185 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <string>
+#include "bitboard.h"
+#include "piece.h"
+#include "move.h"
+#include "psqt.h"
+
+//Qt에 의존하지 않는 체스판 모델
+//12종류 기물의 비트보드와 64칸 메일박스를 함께 유지하며 게임 상태의 기준이 된다
+
+enum CastlingRight
+{
+    WhiteKingSide = 1,
+    WhiteQueenSide = 2,
+    BlackKingSide = 4,
+    BlackQueenSide = 8
+};
+
+const int NoSquare = 64;//앙파상 칸이 없을때
+const int MaxGamePly = 2048;//한 게임에서 둘 수 있는 최대 수
+const int MaxSearchPly = 256;//탐색이 게임 위에 쌓을 수 있는 수,널 무브 포함
+
+struct StateInfo
+//수를 되돌릴때 필요한 이전 상태,힙을 사용하지 않는 작은 구조체
+{
+    uint64_t key;//이 수를 두기 전 국면의 키,반복 검사에도 사용
+    uint8_t castling;
+    uint8_t enPassant;
+    uint16_t halfmoves;
+    uint16_t pliesFromNull;
+    Piece captured;//이 수로 잡힌 기물
+};
+
+class Board
+{
+public:
+    Board();
+
+    void clear();//빈 판으로 초기화
+    void setStartPosition();//표준 시작 배치
+    bool setFen(const std::string& fen);
+    //FEN 문자열로 배치,형식이 잘못되었거나 규칙상 나올 수 없는 국면이면 false
+    std::string fen() const;
+
+    Piece pieceAt(int square) const
+    {
+        return mailbox[square];
+    }
+    bool isEmpty(int square) const
+    {
+        return mailbox[square] == NoPiece;
+    }
+    Bitboard pieces(Piece piece) const
+    {
+        return pieceBB[piece];
+    }
+    Bitboard pieces(Color color) const
+    {
+        return colorBB[color];
+    }
+    Bitboard pieces(Color color, PieceType type) const
+    {
+        return pieceBB[makePiece(color, type)];
+    }
+    Bitboard pieces(PieceType type) const
+    {
+        return pieceBB[makePiece(White, type)] | pieceBB[makePiece(Black, type)];
+    }
+    Bitboard occupied() const
+    {
+        return colorBB[White] | colorBB[Black];
+    }
+    int kingSquare(Color color) const
+    {
+        return lsb(pieceBB[makePiece(color, King)]);
+    }
+
+    Color sideToMove() const
+    {
+        return side;
+    }
+    int castlingRights() const
+    {
+        return castling;
+    }
+    int epSquare() const
+    {
+        return enPassant;
+    }
+    int halfmoveClock() const
+    {
+        return halfmoves;
+    }
+    int fullmoveNumber() const
+    {
+        return fullmoves;
+    }
+
+    uint64_t key() const//수를 둘때마다 갱신되는 조브리스트 키
+    {
+        return positionKey;
+    }
+    uint64_t computeKey() const;//현재 국면의 조브리스트 키를 처음부터 계산
+    uint64_t pawnKey() const//폰 배치만으로 만든 키,폰 구조 평가 캐시에 사용
+    {
+        return pawnHashKey;
+    }
+    Score psqScore() const//기물 가치와 칸 점수의 합,백 기준이며 기물을 놓고 뺄때 갱신
+    {
+        return psq;
+    }
+    int gamePhase() const//남은 기물로 계산한 게임 단계,시작 국면이 MaxPhase이고 폰과 킹만 남으면 0
+    {
+        return phase;
+    }
+    int gamePly() const//되돌릴 수 있는 수의 개수
+    {
+        return stateCount;
+    }
+    int repetitions() const;//현재 국면이 이전에 나온 횟수,마지막 되돌릴 수 없는 수 이후만 검사
+    bool isThreefoldRepetition() const
+    {
+        return repetitions() >= 2;
+    }
+    bool isFiftyMoveDraw() const//폰 이동이나 기물 잡기 없이 50수가 지남
+    {
+        return halfmoves >= 100;
+    }
+
+    Bitboard attackersTo(int square, Bitboard occupied) const;//양쪽 색의 공격 기물 모두
+    bool isValidPosition() const;
+    //수 생성이 가정하는 조건을 검사,1/8랭크의 폰,맞지 않는 캐슬링 권리와 앙파상 칸,두지 않는 쪽의 체크
+    Bitboard checkers() const;//현재 두는 쪽 킹을 공격하는 기물
+    Bitboard pinned(Color color) const;//color의 킹과 상대 슬라이딩 기물 사이에 하나만 있는 color의 기물
+    bool inCheck() const
+    {
+        return checkers() != 0;
+    }
+    bool pseudoLegal(const Move& move) const;
+    //치환표,킬러,카운터 수처럼 다른 국면에서 온 수를 수 생성 없이 검사,자기 킹의 안전은 보지 않음
+    bool legal(const Move& move) const;//pseudoLegal인 수가 자기 킹을 공격받게 두지 않는지
+    int see(const Move& move) const;
+    //정적 교환 평가,도착칸에서 양쪽이 가장 싼 기물로 번갈아 잡았을때 움직인 쪽이 얻는 점수
+    //움직이는 기물의 색을 기준으로 하므로 차례가 아닌 쪽의 잡기도 평가할 수 있음
+    bool seeGe(const Move& move, int threshold) const;//see(move) >= threshold를 빠르게 판정
+
+    void putPiece(Piece piece, int square);//빈 칸에 기물 배치
+    void removePiece(int square);//칸의 기물 제거
+    void movePiece(int from, int to);//도착칸의 기물은 잡힌 것으로 처리,규칙 검사 없음
+    bool editMove(int from, int to);
+    //디버그용 규칙 없는 이동,깨진 캐슬링과 앙파상 권리를 지우고 FEN으로 다시 세움
+    //규칙상 나올 수 없는 국면이 되면 원래 국면을 그대로 두고 false
+
+    void makeMove(const Move& move);//합법수를 두고 비트보드,메일박스,캐슬링,앙파상,키를 갱신
+    void unmakeMove(const Move& move);//마지막으로 둔 수를 되돌림
+    void makeNullMove();//차례만 넘김,체크 상태에서는 사용하지 않음
+    void unmakeNullMove();
+    bool hasNonPawnMaterial(Color color) const//폰과 킹 외의 기물이 있는지,널 무브의 추크츠방 검사용
+    {
+        return (colorBB[color] & ~pieces(Pawn) & ~pieces(King)) != 0;
+    }
+
+private:
+    Bitboard pieceBB[12];
+    Bitboard colorBB[2];
+    Piece mailbox[64];
+
+    Color side;
+    int castling;
+    int enPassant;
+    int halfmoves;
+    int fullmoves;
+    uint64_t positionKey;
+    uint64_t pawnHashKey;
+    Score psq;
+    int phase;
+    int pliesFromNull;//마지막 널 무브 이후 둔 수,반복 검사는 널 무브를 넘어가지 않음
+
+    StateInfo states[MaxGamePly + MaxSearchPly];//미리 할당된 되돌리기 스택,게임 수와 탐색 깊이를 함께 담음
+    int stateCount;
+};
+
+#endif // BOARD_H
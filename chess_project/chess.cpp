@@ -1,17 +1,66 @@
 #include "chess.h"
 #include "./ui_chess.h"
+#include "attacks.h"
+#include "tables.h"
+#include "movegen.h"
+#include "nnue.h"
+#include <QCoreApplication>
+#include <QHash>
+#include <QImage>
 #include <QBrush>
+#include <QPainter>
 #include <QPen>
 #include <QVBoxLayout>
 #include <QDialog>
 #include <QPushButton>
 
+static QString pieceImagePath(Piece piece)//모델의 기물에 맞는 이미지 경로
+{
+    static const char* paths[12] = {
+        ":/images/white_pawn.png", ":/images/white_knight.png", ":/images/white_bishop.png",
+        ":/images/white_rook.png", ":/images/white_queen.png", ":/images/white_king.png",
+        ":/images/black_pawn.png", ":/images/black_knight.png", ":/images/black_bishop.png",
+        ":/images/black_rook.png", ":/images/black_queen.png", ":/images/black_king.png"
+    };
+    return paths[piece];
+}
+
+static QPixmap pieceSprite(Piece piece, int size, qreal devicePixelRatio)
+//기물 이미지를 (기물,크기,화면 배율)마다 한번만 만들어 재사용
+//QPixmap은 암시적으로 공유되므로 같은 기물을 그리는 아이템들은 픽셀 데이터를 함께 사용
+{
+    static QImage images[12];//디코딩한 원본,기물마다 처음 한번만 읽음
+    static QHash<quint64, QPixmap> sprites;
+
+    quint64 key = (quint64(piece) << 48) | (quint64(size) << 32) | quint64(qRound(devicePixelRatio * 100));
+    QPixmap sprite = sprites.value(key);
+    if (!sprite.isNull())
+    {
+        return sprite;
+    }
+
+    if (images[piece].isNull())
+    {
+        images[piece] = QImage(pieceImagePath(piece));
+    }
+    int pixels = qRound(size * devicePixelRatio);//고해상도 화면에서는 실제 픽셀 크기로 축소
+    QImage scaled = images[piece].scaled(pixels, pixels, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(devicePixelRatio);//장면에서는 size x size 크기로 보임
+    sprite = QPixmap::fromImage(scaled);
+    sprites.insert(key, sprite);
+    return sprite;
+}
+
 chess::chess(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::chess), isWhiteTurn(true)
 {
     ui->setupUi(this);
-    scene = new QGraphicsScene(this);//체스 메인판 생성자
+    scene = new BoardScene(this);//체스 메인판 생성자,체스판은 배경으로 그림
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    //기물은 칸 배열로 찾으므로 장면의 공간 색인은 사용하지 않음
     ui->graphicsView->setScene(scene);
+    connect(scene, &BoardScene::devicePixelRatioChanged, this, &chess::refreshSprites, Qt::QueuedConnection);
+    //배경을 그리는 도중에 아이템을 바꾸지 않도록 다음 이벤트에서 처리
 
     QGraphicsScene *whiteGotScene = new QGraphicsScene(this);
     //흰색이 잡은 기물을 보여주는 창 생성자
@@ -23,121 +72,271 @@ chess::chess(QWidget *parent)
 
     qDebug() << "체스 게임이 시작되었습니다. 흰색부터 시작하세요.";
 
-    drawChessBoard();//체스판 그리기
+    createItemPool();
     placePieces();//기물 배치
 
-    updateLCD(whiteTime, ui->white_timer);
-    updateLCD(blackTime, ui->black_timer);
+    updateClockDisplay();
 
-    connect(&whiteTimer, &QTimer::timeout, this, &chess::updateWhiteTimer);
-    connect(&blackTimer, &QTimer::timeout, this, &chess::updateBlackTimer);
+    flagTimer.setSingleShot(true);
+    flagTimer.setTimerType(Qt::PreciseTimer);
+    displayTimer.setSingleShot(true);
+    connect(&flagTimer, &QTimer::timeout, this, &chess::checkTimeOver);
+    connect(&displayTimer, &QTimer::timeout, this, &chess::updateClockDisplay);
     //connect:신호가 발생했을때 슬롯을 자동으로 호출
-    //여기서는 10ms마다 timeout이 발동할때마다 타이머 함수를 작동해 타이머를 업데이트
+    //남은 시간은 시계가 직접 계산하므로 타이머는 시간이 다 되는 순간과 화면 갱신에만 사용
+
+    connect(this, &chess::engineMoveFound, this, &chess::applyEngineMove, Qt::QueuedConnection);
+    //엔진 스레드의 결과를 GUI 이벤트 루프로 넘김
+    int cores = int(std::thread::hardware_concurrency());
+    engine.setThreads(cores > 1 ? cores - 1 : 1);//GUI 스레드가 쓸 코어 하나는 남김
+
+    QString networkPath = QCoreApplication::applicationDirPath() + "/chess.nnue";
+    if (loadNetwork(networkPath.toStdString()))
+    {//실행 파일 옆에 신경망 파일이 있으면 신경망으로 평가,없으면 기존 평가
+        qDebug() << "신경망 평가 사용:" << networkPath << nnueSimdName(nnueSimd());
+    }
 }
 
 chess::~chess()//소멸자
 {
+    engine.stop();//창이 사라지기 전에 탐색 스레드 종료
+    engine.wait();
     delete ui;
 }
 
-void chess::drawChessBoard()
+BoardScene::BoardScene(QObject *parent)
+    : QGraphicsScene(parent)
 {
-    int size = 80;//체스판 한칸의 사이즈,80x80
-    for (int i = 0; i < 8; ++i)
-    {
-        for (int j = 0; j < 8; ++j)
+    setSceneRect(0, 0, 8 * 80, 8 * 80);//아이템이 없어도 장면 크기는 체스판으로 고정
+}
+
+void BoardScene::drawBackground(QPainter *painter, const QRectF& rect)
+//체스판을 한장의 이미지로 그려 장면 영역에만 표시
+//칸마다 아이템을 만들지 않으므로 장면에는 기물 아이템만 남고,이미지는 화면 배율이 바뀔때만 다시 그림
+{
+    QGraphicsScene::drawBackground(painter, rect);//장면 밖은 뷰의 기본 배경
+
+    qreal ratio = painter->device()->devicePixelRatioF();
+    if (boardPixmap.isNull() || boardPixmap.devicePixelRatio() != ratio)
+    {//처음 그릴때나 창이 배율이 다른 화면으로 옮겨졌을때
+        if (!boardPixmap.isNull())
         {
-            QRectF tile(j * size, i * size, size, size);
-            //qt사각형,괄호는 순서대로 x위치,y위치,폭,높이
-            QBrush brush;
-            if ((i + j) % 2 == 0)
+            emit devicePixelRatioChanged();
+        }
+        int size = 80;//체스판 한칸의 사이즈,80x80
+        boardPixmap = QPixmap(qRound(size * 8 * ratio), qRound(size * 8 * ratio));
+        boardPixmap.setDevicePixelRatio(ratio);
+
+        QPainter boardPainter(&boardPixmap);
+        boardPainter.setPen(QPen(Qt::darkGray));//테두리는 어두운 회색
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
             {
-                brush = Qt::white;
-                //색깔 지정,체스판에 맞게 흰색과 검은색 지정
+                QRectF tile(j * size, i * size, size, size);
+                //qt사각형,괄호는 순서대로 x위치,y위치,폭,높이
+                if ((i + j) % 2 == 0)
+                {
+                    boardPainter.setBrush(Qt::white);
+                    //색깔 지정,체스판에 맞게 흰색과 검은색 지정
+                }
+                else
+                {
+                    boardPainter.setBrush(Qt::black);
+                }
+                boardPainter.drawRect(tile);
             }
-            else
+        }
+    }
+    painter->drawPixmap(sceneRect().topLeft(), boardPixmap);
+}
+
+void chess::createItemPool()
+//기물 이미지 객체를 미리 만들어 숨겨 둠,게임 중에는 새로 만들거나 지우지 않고 재사용
+{
+    for (int i = 0; i < ItemPoolSize; ++i)
+    {
+        QGraphicsPixmapItem* item = new QGraphicsPixmapItem();
+        item->setData(0, int(NoPiece));
+        item->hide();
+        scene->addItem(item);//scene이 소유하므로 창이 닫힐때 함께 삭제됨
+        freeItems[i] = item;
+    }
+    freeItemCount = ItemPoolSize;
+}
+
+void chess::placeItem(QGraphicsPixmapItem* item, int square, Piece piece)
+//이미지 객체를 칸에 표시,기물이 바뀐 경우에만 이미지를 교체
+{
+    if (getPiece(item) != piece)
+    {
+        item->setPixmap(pieceSprite(piece, 80, ui->graphicsView->devicePixelRatioF()));
+        //미리 축소해 둔 공유 이미지,다시 디코딩하지 않음
+        item->setData(0, int(piece));//기물 값,이미지 경로는 그릴때만 사용
+    }
+    item->setPos(squarePos(square));
+    item->show();
+    squareItems[square] = item;
+}
+
+void chess::refreshSprites()
+//기물 이미지는 만들때의 배율로 축소되어 있으므로 배율이 바뀌면 모두 교체
+{
+    qreal ratio = ui->graphicsView->devicePixelRatioF();
+    for (QGraphicsPixmapItem* item : squareItems)
+    {
+        if (item)
+        {
+            item->setPixmap(pieceSprite(getPiece(item), 80, ratio));
+        }
+    }
+    for (int i = 0; i < freeItemCount; ++i)
+    {//숨겨 둔 이미지는 다시 쓸때 기물이 같으면 이미지를 바꾸지 않으므로 기물 값을 지워 둠
+        freeItems[i]->setData(0, int(NoPiece));
+    }
+
+    QGraphicsView* storageViews[2] = { ui->white_got, ui->black_got };
+    for (QGraphicsView* storageView : storageViews)
+    {//잡은 기물과 흐린 표시 모두 기물 값을 가지고 있음
+        qreal storageRatio = storageView->devicePixelRatioF();
+        for (QGraphicsItem* item : storageView->scene()->items())
+        {
+            QGraphicsPixmapItem* pixmapItem = qgraphicsitem_cast<QGraphicsPixmapItem*>(item);
+            if (pixmapItem)
             {
-                brush = Qt::black;
+                pixmapItem->setPixmap(pieceSprite(getPiece(pixmapItem), 40, storageRatio));
             }
-            scene->addRect(tile, QPen(Qt::darkGray), brush);
-            //타일을 메인 scene에 추가,테두리는 어두운 회색
         }
     }
 }
 
-QGraphicsPixmapItem* chess::addPiece(const QString& imagePath, int i, int j)
+void chess::syncScene()
+//모델과 화면에 표시된 64칸을 비교해서 바뀐 칸만 갱신
+//같은 기물이 떠난 칸의 이미지는 위치만 옮기고,모자라면 다른 기물 이미지를 교체하거나 숨겨 둔 이미지를 꺼냄
+//수 하나,리셋,국면 불러오기 모두 이 함수 하나로 화면에 반영
 {
-    QPixmap piece(imagePath);//이미지를 보여줄수 있는 qpixmap을 사용해 piece객체 생성
-    piece = piece.scaled(80, 80);//사진의 사이즈
-    QGraphicsPixmapItem* item = new QGraphicsPixmapItem(piece);
-    //piece이미지를 사용하는 생성자,QGraphicsPixmapItem를 사용해 qpixmap을 그래픽 장면에 추가
-    item->setPos(j * 80, i * 80);//위치
-    item->setData(0, imagePath);//이미지 경로
-    scene->addItem(item);//scene에 기물 배치
+    QGraphicsPixmapItem* vacated[64];//이번에 칸을 떠난 이미지
+    int vacatedCount = 0;
+    int needed[64];//새 기물을 표시해야 하는 칸
+    int neededCount = 0;
+
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        Piece piece = board.pieceAt(sq);
+        QGraphicsPixmapItem* item = squareItems[sq];
+        if (piece == (item ? getPiece(item) : NoPiece))
+        {
+            continue;//바뀌지 않은 칸
+        }
+        if (item)
+        {
+            vacated[vacatedCount++] = item;
+            squareItems[sq] = nullptr;
+        }
+        if (piece != NoPiece)
+        {
+            needed[neededCount++] = sq;
+        }
+    }
 
-    return item;
+    for (int i = 0; i < neededCount; ++i)
+    {//같은 기물의 이미지가 있으면 옮기기만 함
+        Piece piece = board.pieceAt(needed[i]);
+        for (int j = 0; j < vacatedCount; ++j)
+        {
+            if (getPiece(vacated[j]) == piece)
+            {
+                placeItem(vacated[j], needed[i], piece);
+                vacated[j] = vacated[--vacatedCount];
+                needed[i] = NoSquare;
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < neededCount; ++i)
+    {//프로모션처럼 기물이 바뀐 칸은 남은 이미지를 교체해서 사용
+        if (needed[i] == NoSquare)
+        {
+            continue;
+        }
+        QGraphicsPixmapItem* item = nullptr;
+        if (vacatedCount > 0)
+        {
+            item = vacated[--vacatedCount];
+        }
+        else if (freeItemCount > 0)
+        {
+            item = freeItems[--freeItemCount];
+        }
+        if (!item)
+        {
+            qDebug() << "에러: 표시할 수 있는 기물 수를 넘었습니다.";
+            continue;
+        }
+        placeItem(item, needed[i], board.pieceAt(needed[i]));
+    }
+
+    for (int j = 0; j < vacatedCount; ++j)
+    {//잡힌 기물의 이미지는 숨겨서 돌려놓음
+        vacated[j]->hide();
+        freeItems[freeItemCount++] = vacated[j];
+    }
 }
 
 void chess::placePieces()
 {
-    // 백 기물 배치
-    for (int i = 0; i < 8; ++i)
-    {
-        addPiece(":/images/white_pawn.png", 6, i);//폰은 8개 배치
-    }
-    addPiece(":/images/white_rook.png", 7, 0);
-    addPiece(":/images/white_knight.png", 7, 1);
-    addPiece(":/images/white_bishop.png", 7, 2);
-    addPiece(":/images/white_queen.png", 7, 3);
-    addPiece(":/images/white_king.png", 7, 4);
-    addPiece(":/images/white_bishop.png", 7, 5);
-    addPiece(":/images/white_knight.png", 7, 6);
-    addPiece(":/images/white_rook.png", 7, 7);
+    board.setStartPosition();//체스판 모델을 시작 배치로 초기화
+    syncScene();//모델에 있는 기물을 그대로 화면에 배치
+}
+
+int chess::toSquare(int row, int col) const
+//화면의 행,열을 모델의 칸 번호로 변환,화면 0행이 8랭크
+{
+    return (7 - row) * 8 + col;
+}
 
-    // 흑 기물 배치
-    for (int i = 0; i < 8; ++i)
+int chess::squareAt(const QPointF& scenePos) const
+//화면 좌표가 있는 칸,체스판 밖이면 NoSquare
+{
+    if (scenePos.x() < 0 || scenePos.y() < 0 || scenePos.x() >= 8 * 80 || scenePos.y() >= 8 * 80)
     {
-        addPiece(":/images/black_pawn.png", 1, i);
+        return NoSquare;
     }
-    addPiece(":/images/black_rook.png", 0, 0);
-    addPiece(":/images/black_knight.png", 0, 1);
-    addPiece(":/images/black_bishop.png", 0, 2);
-    addPiece(":/images/black_queen.png", 0, 3);
-    addPiece(":/images/black_king.png", 0, 4);
-    addPiece(":/images/black_bishop.png", 0, 5);
-    addPiece(":/images/black_knight.png", 0, 6);
-    addPiece(":/images/black_rook.png", 0, 7);
+    return toSquare(int(scenePos.y()) / 80, int(scenePos.x()) / 80);
 }
 
-bool chess::isSameColor(QGraphicsPixmapItem *piece1, QGraphicsPixmapItem *piece2)
-//같은색 기물인지를 검사하는 프로그램
+QPointF chess::squarePos(int square) const
+//칸에 놓인 기물 이미지의 왼쪽 위 좌표
 {
-    QString path1 = piece1->data(0).toString();
-    //data(0)슬롯을 사용해 파일 경로 가져옴
-    QString path2 = piece2->data(0).toString();
-    return path1.contains("white") == path2.contains("white");
-    //bool을 사용해 아이템 두개가 각각 경로에 path를 포함하는지 판단하여 반환
+    return QPointF(fileOf(square) * 80, (7 - rankOf(square)) * 80);
+}
+
+QGraphicsPixmapItem* chess::pieceItemAt(int square) const
+//해당 칸에 표시된 기물 이미지 객체,장면을 검색하지 않고 칸 배열에서 바로 찾음
+{
+    return square == NoSquare ? nullptr : squareItems[square];
 }
 
 void chess::mousePressEvent(QMouseEvent *event)
 {
     QPointF clickPos = ui->graphicsView->mapToScene(event->pos());
     //mapToScene을 사용해 마우스 클릭위치를 가져와 clickpositiond으로 저
-    QGraphicsItem *item = scene->itemAt(clickPos, QTransform());
-    //클릭한 위치에 있는 기물 반환
-    if (item && event->button() == Qt::LeftButton)
-    {//좌클릭 했을때
-        QGraphicsPixmapItem *piece = dynamic_cast<QGraphicsPixmapItem *>(item);
-        //dynamic_cast는 상속관계가 잇는 클래스간 형 변환에 사용된다
-        //QGraphicsPixmapItem의 객체를 다루어 기물이 있는지 검색하기 위해 사용
-        //클릭했을때 아이템이 기물일때만
-        if (piece)
+    int clickSquare = squareAt(clickPos);
+    QGraphicsPixmapItem *piece = pieceItemAt(clickSquare);
+    //클릭한 칸에 있는 기물,칸 배열에서 바로 찾음
+    if (piece && event->button() == Qt::LeftButton)
+    {//좌클릭 했을때,클릭한 칸에 기물이 있을때만
+        if (engineTurn())
+        {
+            qDebug() << "에러: 컴퓨터의 차례입니다.";
+        }
+        else
         {
-            if ((isWhiteTurn && piece->data(0).toString().contains("white")) ||
-                (!isWhiteTurn && piece->data(0).toString().contains("black")))
+            if (colorOf(getPiece(piece)) == (isWhiteTurn ? White : Black))
             {
                 selectedPiece = piece;//선택된 기물 저장
-                originalPos = piece->pos();//선택된 기물의 원래 위치 저장
+                selectedSquare = clickSquare;//선택된 기물이 있던 칸 저장
                 qDebug() << "기물이 선택되었습니다.";//턴에 맞는 기물을 선택했을때만
             }
             else
@@ -155,151 +354,184 @@ void chess::mouseReleaseEvent(QMouseEvent *event)
         qDebug() << "에러: 기물이 선택되지 않았습니다.";
         return;
     }//기물이 선택되지 않을때
-    QPointF releasePos = ui->graphicsView->mapToScene(event->pos());
-    //마우스를 놓은 위치 좌표 포인터 저장
-    int tileSize = 80;
-    int col = static_cast<int>(releasePos.x()) / tileSize;
-    int row = static_cast<int>(releasePos.y()) / tileSize;
-    //좌표를 타일사이즈로 나누어 위치를 n열,n행으로 구분
+    int fromSquare = selectedSquare;
+    int targetSquare = squareAt(ui->graphicsView->mapToScene(event->pos()));
+    //모델에서 사용할 출발칸과 마우스를 놓은 도착칸
 
-    if (row < 0 || row > 7 || col < 0 || col > 7)
+    if (targetSquare == NoSquare)
     {
         qDebug() << "에러: 체스판 외부로 이동할 수 없습니다.";
-        selectedPiece->setPos(originalPos);//변수 초기화
+        selectedPiece->setPos(squarePos(fromSquare));//변수 초기화
         selectedPiece = nullptr;
         return;
     }//체스판 바깥에 기물을 이동하려고 했을때
 
+    Move move;//규칙에 맞는 수,디버그 모드에서는 사용하지 않음
     if (!debugMode)
     {//턴에 관련된 오류 처리, 만약 디버깅 모드라면 턴과 관련없이 작동
         if (pieceMovedInTurn)
         //pieceMovedInTurn변수를 사용해 한턴에 한번만 움직일수 있도록 처리
         {
             qDebug() << "에러: 이번 턴에서 이미 기물이 움직였습니다.";
-            selectedPiece->setPos(originalPos);
+            selectedPiece->setPos(squarePos(fromSquare));
             selectedPiece = nullptr;
             return;
         }
 
-        if ((isWhiteTurn && !selectedPiece->data(0).toString().contains("white")) ||
-            (!isWhiteTurn && selectedPiece->data(0).toString().contains("white")))
+        if (colorOf(getPiece(selectedPiece)) != (isWhiteTurn ? White : Black))
         {
             qDebug() << "에러: 현재 턴의 기물이 아닙니다.";
             //턴이 아닐때 이동을 방지
-            selectedPiece->setPos(originalPos);
+            selectedPiece->setPos(squarePos(fromSquare));
             selectedPiece = nullptr;
             return;
         }
 
-        QString pieceType = getPieceType(selectedPiece);//기물 종류
-        //기물의 이동전 행,열 저장
-        int startRow = static_cast<int>(originalPos.y()) / tileSize;
-        int startCol = static_cast<int>(originalPos.x()) / tileSize;
-
-        if (!isValidMove(pieceType, startRow, startCol, row, col))
-            //행마법에 유효하는지 검사
+        if (!isValidMove(fromSquare, targetSquare, move))
+            //합법수 목록에 있는지 검사
         {
             qDebug() << "에러: 유효하지 않은 움직임입니다. 해당 기물 규칙을 따르지 않았습니다.";
-            selectedPiece->setPos(originalPos);
+            selectedPiece->setPos(squarePos(fromSquare));
             selectedPiece = nullptr;
             return;
         }
-    }
-
-    QGraphicsPixmapItem* capturedPiece = nullptr;
-    //이동 위치에 상대 기물이 있는지 보여주기 위한 변수
-    QList<QGraphicsItem*> items = scene->items(QPointF(col * 80 + 40, row * 80 + 40));
-    //이동 위치에 이미지 객체를 아이템 리스트로 가져옴
 
-    for (int i = 0; i < items.size(); ++i)
-    {
-        if (QGraphicsPixmapItem* pixmapItem = dynamic_cast<QGraphicsPixmapItem*>(items[i]))
+        if (move.moveFlag() == PromotionMove)
         {
-            if (pixmapItem != selectedPiece)
-            {
-                capturedPiece = pixmapItem;
-                break;
-            }
+            move = Move(fromSquare, targetSquare, PromotionMove, promotePawn());
+            //폰이 끝까지 도달했다면 프로모션 기물 선택
         }
     }
 
-    if (capturedPiece)
-    {
-        if (!debugMode && isSameColor(selectedPiece, capturedPiece))
-        {//색깔 검색을 통해 같은 색의 기물은 잡을수 없음
-            qDebug() << "에러: 같은 색의 기물은 잡을 수 없습니다.";
-            selectedPiece->setPos(originalPos);
-            selectedPiece = nullptr;
+    if (debugMode)
+    {//규칙 없이 모델에 이동 반영,킹을 잡으면 게임 종료
+        Piece capturedPiece = targetSquare != fromSquare ? board.pieceAt(targetSquare) : NoPiece;
+        if (capturedPiece != NoPiece && typeOf(capturedPiece) == King)
+        {
+            removeCapturedPiece(targetSquare);
+            finishGame(isWhiteTurn ? "흰색" : "검은색");
             return;
         }
-
-        QString capturedPieceType = getPieceType(capturedPiece);
-        //잡은 기물의 종류를 저장
-        QGraphicsView *storageView;
-        //저장공간 포인터 선언
-
-        if (isWhiteTurn)
+        if (!board.editMove(fromSquare, targetSquare))
         {
-            storageView = ui->white_got;
+            qDebug() << "에러: 규칙상 나올 수 없는 배치입니다. 1/8랭크의 폰이나 두지 않는 쪽의 체크는 허용되지 않습니다.";
+            selectedPiece->setPos(squarePos(fromSquare));
+            selectedPiece = nullptr;
+            return;
         }
-        else
+        if (capturedPiece != NoPiece)
         {
-            storageView = ui->black_got;
+            capturedShow(capturedPiece, isWhiteTurn ? ui->white_got : ui->black_got);
+            qDebug() << "알림: 기물을 잡았습니다!";
         }
-        capturedShow(capturedPiece, storageView);
-        //잡은 기물 표시
+        syncScene();
+        selectedPiece = nullptr;
+        return;
+    }
 
-        if (capturedPieceType == "king")
-        //킹을 잡았다면 게임 종료
-        {
-            if (isWhiteTurn)
-            {
-                finishGame("흰색");
-            }
-            else
-            {
-                finishGame("검은색");
-            }
+    selectedPiece = nullptr;//변수 초기화
+    playMove(move);
+}
 
-            return;
-        }
-        scene->removeItem(capturedPiece);
-        delete capturedPiece;
-        qDebug() << "알림: 기물을 잡았습니다!";
+bool chess::removeCapturedPiece(int square)
+//칸에 있는 기물을 잡은 기물 저장소로 옮김,잡힌 기물이 킹이면 true
+{
+    Piece capturedPiece = board.pieceAt(square);
+    if (capturedPiece == NoPiece)
+    {
+        return false;
     }
 
-    selectedPiece->setPos(col * 80, row * 80);
-    //행과 열에 맞추어 기물의 새로운 위치를 지정
+    capturedShow(capturedPiece, isWhiteTurn ? ui->white_got : ui->black_got);
+    //잡은 기물 표시,판 위의 이미지는 모델에 반영한 뒤 syncScene이 숨김
+    if (typeOf(capturedPiece) == King)
+    {
+        return true;//게임이 끝나면 화면은 초기화됨
+    }
+    qDebug() << "알림: 기물을 잡았습니다!";
+    return false;
+}
 
-    QString pieceType = getPieceType(selectedPiece);//기물의 종류 검색
-    if (!debugMode && pieceType == "pawn" && (row == 0 || row == 7))
+bool chess::playMove(const Move& move)
+//합법수를 모델과 화면에 반영하고 게임이 끝났는지 검사,게임이 끝나면 false
+{
+    int targetSquare = move.to();
+
+    int capturedSquare = targetSquare;
+    if (move.moveFlag() == EnPassantMove)
+    {
+        capturedSquare = board.sideToMove() == White ? targetSquare - 8 : targetSquare + 8;
+        //앙파상으로 잡히는 폰은 도착칸 뒤에 있음
+    }
+    if (move.moveFlag() != CastlingMove && !board.isEmpty(capturedSquare))
     {
-        promotePawn(selectedPiece, row, col);
-        //폰이 끝까지 도달했다면 프로모션 발동
+        removeCapturedPiece(capturedSquare);
     }
 
-    if (!debugMode)
+    board.makeMove(move);//모델에 이동 반영
+    syncScene();
+    //바뀐 칸만 화면에 반영,캐슬링의 룩,앙파상,프로모션도 모두 포함
+
+    pieceMovedInTurn = true;
+    isWhiteTurn = !isWhiteTurn;
+    qDebug() << "알림: 기물이 성공적으로 이동했습니다.";
+
+    GameStatus status = gameStatus(board);//상대가 둘 수 있는 수가 있는지 검사
+    if (status == Checkmate)
+    {
+        if (isWhiteTurn)
+        {
+            finishGame("검은색");
+        }
+        else
+        {
+            finishGame("흰색");
+        }
+        return false;
+    }
+    else if (status == Stalemate)
     {
-        selectedPiece = nullptr;//변수 초기화 및 설정
-        pieceMovedInTurn = true;
-        isWhiteTurn = !isWhiteTurn;
-        qDebug() << "알림: 기물이 성공적으로 이동했습니다.";
+        finishDraw("스테일메이트");
+        return false;
     }
-    else
+    else if (status == FiftyMoveDraw)
     {
-        selectedPiece = nullptr;
+        finishDraw("50수 규칙");
+        return false;
     }
+    else if (status == RepetitionDraw)
+    {
+        finishDraw("3회 동일 국면 반복");
+        return false;
+    }
+    else if (board.gamePly() >= MaxGamePly)
+    {//되돌리기 스택이 가득 차면 더 둘 수 없으므로 무승부로 끝냄
+        finishDraw("최대 수 제한");
+        return false;
+    }
+    else if (board.inCheck())
+    {
+        qDebug() << "알림: 체크!";
+    }
+    showHangingPieces();
+    return true;
 }
 
-void chess::capturedShow(QGraphicsPixmapItem* piece, QGraphicsView* storageView)
+void chess::capturedShow(Piece piece, QGraphicsView* storageView)
 {
     QGraphicsScene *storageScene = storageView->scene();
-    QPixmap pieceImage(piece->data(0).toString());
-    //잡힌 기물을 qpixmap으로 가져옴
-
-    pieceImage = pieceImage.scaled(40, 40);//기물 이미지 사이즈
+    QList<QGraphicsPixmapItem*>& hanging = hangingItems[storageView == ui->white_got ? White : Black];
+    for (QGraphicsPixmapItem* item : hanging)
+    {//흐린 표시는 잡은 기물 뒤에 다시 그림
+        storageScene->removeItem(item);
+        delete item;
+    }
+    hanging.clear();
+    QPixmap pieceImage = pieceSprite(piece, 40, storageView->devicePixelRatioF());
+    //잡힌 기물 이미지,저장소 크기로 축소된 공유 이미지를 사용
     QGraphicsPixmapItem *storedItem = new QGraphicsPixmapItem(pieceImage);
     //기물 이미지를 storedItem포인터에 저장,동적할당
+    storedItem->setData(0, int(piece));//화면 배율이 바뀌면 이 값으로 이미지를 다시 가져옴
     int itemCount = storageScene->items().size();
     //저장소에 있는 기물 갯수 가져옴
     int row = itemCount / 4;//갯수에 맞게 행열 재조정
@@ -308,6 +540,55 @@ void chess::capturedShow(QGraphicsPixmapItem* piece, QGraphicsView* storageView)
     storageScene->addItem(storedItem);//저장소에 기물 표현
 }
 
+void chess::showHangingPieces()
+{
+    for (int color = White; color <= Black; ++color)
+    {
+        QGraphicsView *storageView = color == White ? ui->white_got : ui->black_got;
+        QGraphicsScene *storageScene = storageView->scene();
+        QList<QGraphicsPixmapItem*>& hanging = hangingItems[color];
+        for (QGraphicsPixmapItem* item : hanging)
+        {
+            storageScene->removeItem(item);
+            delete item;
+        }
+        hanging.clear();
+
+        int itemCount = storageScene->items().size();//잡은 기물 다음 칸부터 표시
+        Bitboard targets = board.pieces(Color(color ^ 1)) & ~board.pieces(King);
+        while (targets)
+        {
+            int square = popLsb(targets);
+            Bitboard attackers = board.attackersTo(square, board.occupied()) & board.pieces(Color(color));
+            Bitboard pinned = board.pinned(Color(color));
+            int kingSq = board.kingSquare(Color(color));
+            bool winning = false;
+            while (attackers && !winning)
+            {//가장 유리한 공격 기물로 잡았을때 교환에서 이득이면 표시
+                int from = popLsb(attackers);
+                if ((pinned & squareBit(from)) && !aligned(kingSq, from, square))
+                {
+                    continue;//핀된 기물은 핀 직선 위의 기물만 잡을 수 있음
+                }
+                winning = board.see(Move(from, square)) > 0;//킹으로 지켜지는 기물을 잡는 수는 음수
+            }
+            if (!winning)
+            {
+                continue;
+            }
+
+            QPixmap pieceImage = pieceSprite(board.pieceAt(square), 40, storageView->devicePixelRatioF());
+            QGraphicsPixmapItem *hangingItem = new QGraphicsPixmapItem(pieceImage);
+            hangingItem->setOpacity(0.35);//잡은 기물과 구분되도록 흐리게
+            hangingItem->setData(0, int(board.pieceAt(square)));
+            hangingItem->setPos((itemCount % 4) * 40, (itemCount / 4) * 40);
+            storageScene->addItem(hangingItem);
+            hanging.append(hangingItem);
+            ++itemCount;
+        }
+    }
+}
+
 void chess::updateLCD(int timeMs, QLCDNumber *lcd)
 {
     int minutes = (timeMs / 60000) % 60;//분 표시
@@ -316,321 +597,155 @@ void chess::updateLCD(int timeMs, QLCDNumber *lcd)
     //2자리수로 0을 채워 시간 표시
 }
 
-void chess::updateWhiteTimer()
+void chess::updateClockDisplay()
 {
-    whiteTime -= 10;//총 시간에서 10ms를 감소
-    updateLCD(whiteTime, ui->white_timer);//감소된 시간을 표현
+    updateLCD(clock.remaining(White), ui->white_timer);
+    updateLCD(clock.remaining(Black), ui->black_timer);
 
-    if (whiteTime <= 0)
-    {
-        whiteTimer.stop();//시간 음수표현 방지
+    if (clock.running())
+    {//표시된 초가 바뀌는 순간에 다시 갱신
+        int left = clock.remaining(clock.runningSide());
+        displayTimer.start(left > 0 ? left % 1000 + 1 : 1000);
     }
 }
 
-void chess::updateBlackTimer()
+void chess::scheduleClock()
 {
-    blackTime -= 10;
-    updateLCD(blackTime, ui->black_timer);
-
-    if (blackTime <= 0)
+    flagTimer.stop();
+    displayTimer.stop();
+    if (clock.running())
     {
-        blackTimer.stop();
+        flagTimer.start(clock.msUntilFlag());
     }
+    updateClockDisplay();
 }
 
 void chess::on_white_done_clicked()
 {
     if (!pieceMovedInTurn) return;
 
-    whiteTimer.stop();//턴이 종료됬기 때문에 타이머 종료
-    blackTimer.start(10);//10ms마다 timeout발동
+    clock.press(White);//백의 시계를 멈추고 흑의 시계를 시작
+    scheduleClock();
     isWhiteTurn = false;
     pieceMovedInTurn = false;
     updateTurn();//턴 관련 기능
     qDebug() << "백의 턴이 끝났습니다. 흑의 차례입니다.";
+
+    if (engineTurn())
+    {
+        startEngine();
+    }
 }
 
 void chess::on_black_done_clicked()
 {
     if (!pieceMovedInTurn) return;
 
-    blackTimer.stop();
-    whiteTimer.start(10);
+    clock.press(Black);
+    scheduleClock();
     isWhiteTurn = true;
     pieceMovedInTurn = false;
     updateTurn();
     qDebug() << "흑의 턴이 끝났습니다. 백의 차례입니다.";
 }
 
-QString chess::getPieceType(QGraphicsPixmapItem* piece)
-//기물의 종류를 알아내는 함수
+Piece chess::getPiece(QGraphicsPixmapItem* piece) const
+//기물 이미지 객체에 저장된 기물 값,정수 비교만으로 색과 종류를 알 수 있음
 {
-    QString path = piece->data(0).toString();//이미지 경로에 각각 단어가 포함되있는지 확인
-    if (path.contains("pawn"))
-    {
-        return "pawn";
-    }
-    if (path.contains("rook"))
-    {
-        return "rook";
-    }
-    if (path.contains("knight"))
-    {
-        return "knight";
-    }
-    if (path.contains("bishop"))
-    {
-        return "bishop";
-    }
-    if (path.contains("queen"))
-    {
-        return "queen";
-    }
-    if (path.contains("king"))
-    {
-        return "king";
-    }
-    return "";
+    return Piece(piece->data(0).toInt());
 }
 
-bool chess::isValidMove(const QString& pieceType, int startRow, int startCol, int endRow, int endCol)
+bool chess::isValidMove(int fromSquare, int targetSquare, Move& move)
 {
-    int rowDiff = endRow - startRow;
-    int colDiff = endCol - startCol;
-    //행열 이동 거리 계산및 변수에 저장
-
-    if (endRow < 0 || endRow > 7 || endCol < 0 || endCol > 7)
+    if (fromSquare == NoSquare || targetSquare == NoSquare)
     {
         return false;
         //체스판을 벗어나는 이동 검사
     }
 
-    QGraphicsPixmapItem* targetPiece = nullptr;
-    //이동위치에 있는 기물을 저장하는 포인터
-    QList<QGraphicsItem*> items = scene->items(QPointF(endCol * 80 + 40, endRow * 80 + 40));
-    for (QGraphicsItem* item : items)
+    MoveList legalMoves;
+    generateLegalMoves(board, legalMoves);
+    //현재 국면의 합법수를 모두 만들어 출발칸과 도착칸이 같은 수를 찾음
+    //체크,핀,캐슬링,앙파상이 모두 반영되어 있음
+    for (const Move& legal : legalMoves)
     {
-        if (QGraphicsPixmapItem* pixmapItem = dynamic_cast<QGraphicsPixmapItem*>(item))
+        if (legal.from() == fromSquare && legal.to() == targetSquare)
         {
-            //위치에 있는 아이템을 가져와 기물이 있다면 targetPiece에 저장
-            targetPiece = pixmapItem;
-            break;
+            move = legal;//프로모션은 여러개지만 종류는 나중에 선택
+            return true;
         }
     }
 
-    if (isWhiteTurn)
-    {
-        qDebug() << "기물색: 흰색";//디버깅을 위해 기물색 표시
-    }
-    else
-    {
-        qDebug() << "기물색: 검은색";
-    }
-    qDebug() << "가로 칸수:" << rowDiff;
-    qDebug() << "세로 칸수:" << colDiff;
-    //디버깅을 위해 행열 이동 칸수 표시
-    if (targetPiece != nullptr)
-    {
-        qDebug() << "상대 기물이 존재함";
-        //디버깅을 위해 상대기물이 있는지 표시
-    }
-    else
-    {
-        qDebug() << "상대 기물이 존재하지 않음";
-    }
-
-
-    if (pieceType == "pawn")
-    {
-        if (colDiff == 0)//세로 방향 전진일때
-        {
-            if (targetPiece)
-            {
-                //폰은 전진으로 기물을 잡을수 없음
-                qDebug() << "경로에 기물이 있습니다";
-                return false;
-            }
-
-            if (isWhiteTurn)
-            {
-                if (rowDiff == -1)
-                {
-                    //경로에 기물이 없다면 한칸 전진은 유효
-                    return true;
-                }
-                if (startRow == 6 && rowDiff == -2)
-                {
-                    //시작 위치에서는 두칸도 움직일수 있음
-                    QList<QGraphicsItem*> Items = scene->items(QPointF(startCol * 80 + 40, (startRow - 1) * 80 + 40));
-                    //두칸 이동중 가운데있는 항목 가져옴
-                    bool midPathClear = true;
-                    //중간에 기물이 있는지에 대한 변수
-                    for (QGraphicsItem* item : Items)
-                    {//만약 중간에 기물이 있다면 경로 불가능으로 반환
-                        if (dynamic_cast<QGraphicsPixmapItem*>(item))
-                        {
-                            midPathClear = false;
-                            break;
-                        }
-                    }
-                    return midPathClear;
-                }
-            }
-            else//흑색폰의 이동
-            {
-                if (rowDiff == 1)
-                {
-                    return true;
-                }
-                if (startRow == 1 && rowDiff == 2)
-                {
-                    QList<QGraphicsItem*> midItems = scene->items(QPointF(startCol * 80 + 40, (startRow + 1) * 80 + 40));
-                    bool midPathClear = true;
-                    for (QGraphicsItem* item : midItems)
-                    {
-                        if (dynamic_cast<QGraphicsPixmapItem*>(item))
-                        {
-                            midPathClear = false;
-                            break;
-                        }
-                    }
-                    return midPathClear;
-                }
-            }
-        }
-
-        if (abs(colDiff) == 1)//대각선으로 움직일때
-        {
-            if (isWhiteTurn && rowDiff == -1)
-            {
-                //상대 기물이 있는지 확인하고 같은색의 기물이 아닌지 확인
-                //만약 둘다 유효하다면 이동은 유효
-                return targetPiece && !isSameColor(selectedPiece, targetPiece);
-            }
-            if (!isWhiteTurn && rowDiff == 1)
-            {
-                return targetPiece && !isSameColor(selectedPiece, targetPiece);
-            }
-        }
-
-        return false;//아닌경우 폰은 움직일수 없음
-    }
-
-    if (pieceType == "rook")
-    {
-        return (startRow == endRow || startCol == endCol) && isPathClear(startRow, startCol, endRow, endCol);
-        //룩은 가로혹은 세로로만 움직일수 있으며
-        //경로에 기물이 없어야 함
-    }
-
-    if (pieceType == "bishop")
-    {
-        return abs(endRow - startRow) == abs(endCol - startCol) && isPathClear(startRow, startCol, endRow, endCol);
-        //비숍은 대각선으로만 움직여야함으로
-        //가로세로 이동칸수 차이가 같고 경로에 기물이 없어야함
-    }
-
-    if (pieceType == "queen")
-    {
-        return (startRow == endRow || startCol == endCol || abs(endRow - startRow) == abs(endCol - startCol)) &&
-               isPathClear(startRow, startCol, endRow, endCol);
-        //퀸은 룩과 비숍이 합쳐진 형태
-    }
-
-    if (pieceType == "knight")
-    {
-        return (abs(endRow - startRow) == 2 && abs(endCol - startCol) == 1) ||
-               (abs(endRow - startRow) == 1 && abs(endCol - startCol) == 2);
-        //나이트는 가로 두칸+세로 한칸
-        //또는 세로 한칸+가로 두칸으로 이동 가능
-    }
-
-    if (pieceType == "king")
+    qDebug() << "합법수 개수:" << legalMoves.size();
+    //디버깅을 위해 현재 합법수 개수 표시
+    if (board.inCheck())
     {
-        return abs(endRow - startRow) <= 1 && abs(endCol - startCol) <= 1;
-        //킹은 어느방향으로든 한칸 이동 가능
+        qDebug() << "체크 상태입니다";
     }
-
     return false;
 }
 
-bool chess::isPathClear(int startRow, int startCol, int endRow, int endCol)
+void chess::stopEngine()
+//탐색을 끝내고 스레드를 기다린 뒤,이미 보낸 결과도 적용되지 않도록 탐색 번호를 바꿈
 {
-    int rowStep;//진행해야 하는 행과 열변수
-    int colStep;
-
-    if ((endRow - startRow) == 0)//열 계산
-    {
-        rowStep = 0;
-    }
-    else
-    {
-        rowStep = (endRow - startRow) / abs(endRow - startRow);
-        //진행 방향의 방향 계산
-    }
-
-    if ((endCol - startCol) == 0)//행 계산
-    {
-        colStep = 0;
-    }
-    else
-    {
-        colStep = (endCol - startCol) / abs(endCol - startCol);
-    }
-
-    int currentRow = startRow + rowStep;
-    int currentCol = startCol + colStep;
-    //current:진행방향을 한칸씩 이동하면서 검사하기 위한 변수
-    //Step이 더해지는 이유는 시작위치에 있는 원래 기물을 제외하기 위해서
-
-    while (currentRow != endRow || currentCol != endCol)
-    //위치가 목표 위치에 도달할때까지 반복
-    {
-        QList<QGraphicsItem*> items = scene->items(QPointF(currentCol * 80 + 40, currentRow * 80 + 40));
-        //진행 방향에 기물이 있는지 검사
-        for (QGraphicsItem* item : items)
-        {
-            if (dynamic_cast<QGraphicsPixmapItem*>(item))
-            {
-                return false;
-                //경로에 기물이 있다면 반환
-            }
-        }
+    engine.stop();
+    engine.wait();
+    ++searchId;
+}
 
-        currentRow += rowStep;//한칸씩 이동
-        currentCol += colStep;
-    }
-    return true;
+void chess::stopGame()
+//결과 창을 띄우기 전에 엔진과 시계를 멈춤,창이 떠 있는 동안 수가 적용되거나 시간패가 나지 않도록
+{
+    stopEngine();
+    clock.stop();
+    scheduleClock();//멈춘 시계는 두 타이머를 모두 멈추고 화면만 갱신
 }
 
 void chess::finishGame(const QString& winner)
 {
+    stopGame();
     QMessageBox::information(this, "게임 종료", winner + " 승리!");
     //qmessage로 승패 표시
     resetGame();//초기화
 }
 
+void chess::finishDraw(const QString& reason)
+{
+    stopGame();
+    QMessageBox::information(this, "게임 종료", reason + " 무승부!");
+    //qmessage로 무승부 표시
+    resetGame();//초기화
+}
+
 void chess::checkTimeOver()//시간에 의한 승패
 {
-    if (whiteTime <= 0)
+    if (clock.flagged(White))
     {
-        finishGame("검은색");
+        finishGame("검은색");//탐색과 시계는 finishGame에서 멈춤
     }
-    else if (blackTime<= 0)
+    else if (clock.flagged(Black))
     {
         finishGame("흰색");
     }
+    else if (clock.running())
+    {//타이머가 조금 일찍 깨어났으면 남은 만큼 다시 예약
+        flagTimer.start(clock.msUntilFlag());
+    }
 }
 
 void chess::resetGame()
 {
-    scene->clear();//scene초기화
+    stopEngine();//진행중인 탐색 결과는 버림
+    engine.clearHash();
+    selectedPiece = nullptr;//기물 이미지는 지우지 않고 placePieces에서 바뀐 칸만 되돌림
 
     pieceMovedInTurn = false;//변수 초기화
     isWhiteTurn = true;
 
     updateTurn();//다시 흰색 턴으로
 
+    hangingItems[White].clear();//저장소를 비우면서 함께 삭제됨
+    hangingItems[Black].clear();
     if (ui->white_got->scene())//잡힌 기물 저장소 초기화
     {
         ui->white_got->scene()->clear();
@@ -640,14 +755,9 @@ void chess::resetGame()
         ui->black_got->scene()->clear();
     }
 
-    whiteTimer.stop();//타이머 초기화
-    blackTimer.stop();
-    whiteTime = 600000;
-    blackTime = 600000;
-    updateLCD(whiteTime, ui->white_timer);
-    updateLCD(blackTime, ui->black_timer);
+    clock.reset(clock.timeControl());//시계 초기화,시간 규칙은 유지
+    scheduleClock();
 
-    drawChessBoard();
     placePieces();
 
     qDebug() << "게임이 초기화되었습니다. 백의 턴입니다.";
@@ -692,7 +802,7 @@ void chess::updateTurn()//턴을 알려주는 qtextbrowser
     }
 }
 
-void chess::promotePawn(QGraphicsPixmapItem* pawn, int row, int col)
+PieceType chess::promotePawn()
 {
     QDialog promotion(this);//qdialog 생성
     promotion.setWindowTitle("프로모션 선택");//제목은 프로모션 선택
@@ -711,46 +821,31 @@ void chess::promotePawn(QGraphicsPixmapItem* pawn, int row, int col)
     layout->addWidget(knightButton);
     //버튼을 레이아웃에 추가
 
-    QString color;//기물 변환을 위한 색깔 변수
-    if (pawn->data(0).toString().contains("white"))
-    //기물색깔 검사
-    {
-        color = "white";
-    }
-    else
-    {
-        color = "black";
-    }
+    PieceType chosen = Queen;//선택 없이 창을 닫으면 퀸
 
     connect(queenButton, &QPushButton::clicked, [&]()
-            {//connect를 사용해 버튼을 클릭했을때 기물 변환 작동
-        changePiece(pawn, QString(":/images/%1_queen.png").arg(color), row, col);
+            {//connect를 사용해 버튼을 클릭했을때 선택한 기물 저장
+        chosen = Queen;
         promotion.accept();//기물 선택창 닫기
     });
     connect(rookButton, &QPushButton::clicked, [&]()
             {
-        changePiece(pawn, QString(":/images/%1_rook.png").arg(color), row, col);
+        chosen = Rook;
         promotion.accept();
     });
     connect(bishopButton, &QPushButton::clicked, [&]()
             {
-        changePiece(pawn, QString(":/images/%1_bishop.png").arg(color), row, col);
+        chosen = Bishop;
         promotion.accept();
     });
     connect(knightButton, &QPushButton::clicked, [&]()
             {
-        changePiece(pawn, QString(":/images/%1_knight.png").arg(color), row, col);
+        chosen = Knight;
         promotion.accept();
     });
 
     promotion.exec();
-}
-
-void chess::changePiece(QGraphicsPixmapItem* oldPiece, const QString& newImagePath, int row, int col)//프로모션에 사용되는 기물 변환 함수
-{
-    scene->removeItem(oldPiece);//화면에서 기존 기물 삭제,프로모션에서 사용될경우 항상 폰
-    delete oldPiece;//메모리 해제
-    QGraphicsPixmapItem* newPiece = addPiece(newImagePath, row, col);//동적할당해 포인터에 저장
+    return chosen;
 }
 
 void chess::on_debug_button_clicked()
@@ -767,3 +862,71 @@ void chess::on_debug_button_clicked()
         resetGame();
     }
 }
+
+bool chess::engineTurn() const
+//컴퓨터가 흑을 두고 있고 흑이 아직 수를 두지 않았을때
+{
+    return ui->engine_check->isChecked() && !debugMode && !isWhiteTurn && !pieceMovedInTurn;
+}
+
+void chess::startEngine()
+{
+    SearchLimits limits;
+    limits.timeLeftMs = clock.remaining(Black);
+    limits.incrementMs = clock.timeControl().incrementMs;//지연 방식이면 매 수 돌려받는 시간
+    //남은 시간으로 이번 수에 쓸 시간을 엔진이 정함
+
+    quint32 id = ++searchId;//이 탐색의 결과인지 applyEngineMove에서 확인
+    engine.start(board, limits, [this, id](const SearchResult& result)
+    {//작업 스레드에서 호출되므로 신호만 보냄
+        qDebug() << "탐색 깊이" << result.depth << "점수" << result.score
+                 << "노드" << result.nodes << "nps" << result.nps() << "해시 사용" << result.hashfull << "/1000";
+        for (size_t i = 0; i < result.threadNodes.size(); ++i)
+        {//스레드별 속도,스레드 수에 비례해 늘어나는지 확인
+            qDebug() << "  스레드" << i << "nps"
+                     << (result.timeMs > 0 ? result.threadNodes[i] * 1000 / uint64_t(result.timeMs) : result.threadNodes[i]);
+        }
+        emit engineMoveFound(result.bestMove.raw(), id);
+    });
+    ui->textBrowser->setText("컴퓨터가 생각중입니다");
+}
+
+void chess::applyEngineMove(quint16 rawMove, quint32 id)
+{
+    Move move = Move::fromRaw(rawMove);
+    if (id != searchId || !engineTurn() || move.isNone())
+    {
+        return;//게임이 초기화되었거나 모드가 바뀐 뒤 도착한 결과
+    }
+    if (!clock.running() || clock.flagged(Black))
+    {
+        return;//시간이 다 되어 게임이 끝난 뒤 도착한 결과
+    }
+
+    Move legal;
+    if (!isValidMove(move.from(), move.to(), legal))
+    {
+        return;
+    }
+    qDebug() << "컴퓨터의 수:" << QString::fromStdString(moveToString(move));
+
+    if (playMove(move))
+    {
+        on_black_done_clicked();//게임이 끝나지 않았다면 백에게 차례를 넘김
+    }
+}
+
+void chess::on_engine_check_toggled(bool checked)
+{
+    if (!checked)
+    {
+        stopEngine();
+        qDebug() << "컴퓨터 상대가 꺼졌습니다.";
+        return;
+    }
+    qDebug() << "컴퓨터가 흑을 둡니다.";
+    if (engineTurn())
+    {
+        startEngine();
+    }
+}
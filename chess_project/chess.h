@@ -9,6 +9,27 @@
 #include <QMouseEvent>
 #include <QDebug>
 #include <QMessageBox>
+#include "board.h"
+#include "chessclock.h"
+#include "search.h"
+
+class BoardScene : public QGraphicsScene
+//체스판을 배경으로 그리는 메인 장면
+{
+    Q_OBJECT
+
+public:
+    explicit BoardScene(QObject *parent = nullptr);
+
+signals:
+    void devicePixelRatioChanged();//배경을 다시 그린 배율이 이전과 다름,기물 이미지도 다시 가져와야 함
+
+protected:
+    void drawBackground(QPainter *painter, const QRectF& rect) override;
+
+private:
+    QPixmap boardPixmap;//체스판 이미지,화면 배율이 바뀌면 다시 그림
+};
 
 namespace Ui
 {
@@ -31,45 +52,69 @@ private:
     Ui::chess *ui;
     QGraphicsScene *scene;
     QGraphicsPixmapItem *selectedPiece = nullptr;
-    QPointF originalPos;
+    int selectedSquare = NoSquare;//선택된 기물이 있던 칸
+    QGraphicsPixmapItem* squareItems[64] = {};//칸별로 표시된 기물 이미지,없으면 nullptr
+    static const int ItemPoolSize = 32;//한 국면에 놓일 수 있는 최대 기물 수
+    QGraphicsPixmapItem* freeItems[ItemPoolSize] = {};//숨겨 둔 기물 이미지
+    int freeItemCount = 0;
+    Board board;//게임 상태의 기준이 되는 체스판 모델
 
     bool isWhiteTurn = true;
     bool debugMode = false;
     bool pieceMovedInTurn = false;
 
-    int whiteTime= 600000;
-    int blackTime = 600000;
+    ChessClock clock;//양쪽 남은 시간,기본 10분
+    Search engine;//흑을 두는 컴퓨터 상대,작업 스레드에서 탐색
+    quint32 searchId = 0;//마지막으로 시작한 탐색 번호,다른 번호의 결과는 버림
+    QList<QGraphicsPixmapItem*> hangingItems[2];//저장소에 흐리게 표시한 기물,[잡을 수 있는 쪽]
 
-    bool isValidMove(const QString& pieceType, int startRow, int startCol, int endRow, int endCol);
-    bool isPathClear(int startRow, int startCol, int endRow, int endCol);
-    QString getPieceType(QGraphicsPixmapItem* piece);
+    bool isValidMove(int fromSquare, int targetSquare, Move& move);
+    Piece getPiece(QGraphicsPixmapItem* piece) const;
+    int toSquare(int row, int col) const;
+    int squareAt(const QPointF& scenePos) const;
+    QPointF squarePos(int square) const;
+    QGraphicsPixmapItem* pieceItemAt(int square) const;
 
     void updateTurn();
     void resetGame();
-    void checkTimeOver();
+    void checkTimeOver();//시간이 떨어졌으면 게임을 끝내고,아니면 다음 확인을 예약
     void finishGame(const QString& winner);
-    void drawChessBoard();
-    void capturedShow(QGraphicsPixmapItem* piece, QGraphicsView* storageView);
+    void finishDraw(const QString& reason);
+    void capturedShow(Piece piece, QGraphicsView* storageView);
+    void showHangingPieces();//각 저장소에 지금 이득을 보며 잡을 수 있는 상대 기물을 흐리게 표시
+
+    bool removeCapturedPiece(int square);
+    bool playMove(const Move& move);
+    bool engineTurn() const;
+    void startEngine();
+    void stopEngine();
+    void stopGame();
 
-    void promotePawn(QGraphicsPixmapItem* pawn, int row, int col);
-    void changePiece(QGraphicsPixmapItem* oldPiece, const QString& newImagePath, int row, int col);
-    QGraphicsPixmapItem* addPiece(const QString& imagePath, int row, int col);
+    PieceType promotePawn();
+    void createItemPool();
+    void placeItem(QGraphicsPixmapItem* item, int square, Piece piece);
+    void syncScene();//모델과 다른 칸만 화면에 반영
     void placePieces();
     void updateLCD(int timeMs, QLCDNumber *lcd);
-    bool isSameColor(QGraphicsPixmapItem *piece1, QGraphicsPixmapItem *piece2);
+    void scheduleClock();//시계 상태에 맞춰 두 타이머를 다시 예약
+
+    QTimer flagTimer;//움직이는 쪽의 시간이 다 되는 순간에 한번 발동
+    QTimer displayTimer;//표시된 초가 바뀌는 순간에 화면만 갱신
 
-    QTimer whiteTimer;
-    QTimer blackTimer;
+signals:
+    void engineMoveFound(quint16 move, quint32 id);//작업 스레드에서 보내고 GUI 스레드에서 받음,id는 탐색 번호
 
 private slots:
-    void updateWhiteTimer();
-    void updateBlackTimer();
+    void applyEngineMove(quint16 move, quint32 id);
+    void on_engine_check_toggled(bool checked);
+    void updateClockDisplay();
     void on_white_done_clicked();
     void on_black_done_clicked();
     void on_white_giveup_clicked();
     void on_black_giveup_clicked();
     void on_help_button_clicked();
     void on_debug_button_clicked();
+    void refreshSprites();//판과 저장소의 모든 기물 이미지를 현재 화면 배율로 다시 가져옴
 };
 
 #endif // CHESS_H
@@ -0,0 +1,106 @@
+#include "chessclock.h"
+
+ChessClock::ChessClock(int initialMs)
+{
+    reset(initialMs);
+}
+
+void ChessClock::reset(int initialMs)
+{
+    TimeControl timeControl = control;
+    timeControl.initialMs = initialMs;
+    reset(timeControl);
+}
+
+void ChessClock::reset(const TimeControl& timeControl)
+{
+    control = timeControl;
+    banked[White] = std::chrono::milliseconds(control.initialMs);
+    banked[Black] = std::chrono::milliseconds(control.initialMs);
+    side = White;
+    isRunning = false;
+}
+
+ChessClock::Clock::duration ChessClock::used(Clock::time_point now) const
+{
+    Clock::duration elapsed = now - turnStart;
+    if (control.mode == SimpleDelay)
+    {//지연 시간이 지난 뒤부터 줄어듦
+        elapsed -= std::chrono::milliseconds(control.incrementMs);
+        if (elapsed < Clock::duration::zero())
+        {
+            elapsed = Clock::duration::zero();
+        }
+    }
+    return elapsed;
+}
+
+void ChessClock::press(Color mover, Clock::time_point now)
+{
+    if (isRunning && side == mover)
+    {
+        Clock::duration elapsed = now - turnStart;
+        banked[mover] -= used(now);
+        if (banked[mover] > Clock::duration::zero())
+        {//시간이 남아있을때만 추가 시간을 받음
+            if (control.mode == FischerIncrement)
+            {
+                banked[mover] += std::chrono::milliseconds(control.incrementMs);
+            }
+            else if (control.mode == BronsteinDelay)
+            {
+                Clock::duration delay = std::chrono::milliseconds(control.incrementMs);
+                banked[mover] += elapsed < delay ? elapsed : delay;
+            }
+        }
+    }
+    side = Color(mover ^ 1);
+    turnStart = now;
+    isRunning = true;
+}
+
+void ChessClock::stop(Clock::time_point now)
+{
+    if (isRunning)
+    {
+        banked[side] -= used(now);
+    }
+    isRunning = false;
+}
+
+int ChessClock::remaining(Color color, Clock::time_point now) const
+{
+    Clock::duration left = banked[color];
+    if (isRunning && color == side)
+    {
+        left -= used(now);
+    }
+    if (left <= Clock::duration::zero())
+    {
+        return 0;
+    }
+    return int(std::chrono::duration_cast<std::chrono::milliseconds>(left).count());
+}
+
+int ChessClock::msUntilFlag(Clock::time_point now) const
+{
+    if (!isRunning)
+    {
+        return -1;
+    }
+    Clock::duration left = banked[side] - used(now);
+    if (control.mode == SimpleDelay)
+    {//지연 시간중에는 시계가 줄지 않으므로 그만큼 늦게 떨어짐
+        Clock::duration delayLeft = std::chrono::milliseconds(control.incrementMs) - (now - turnStart);
+        if (delayLeft > Clock::duration::zero())
+        {
+            left += delayLeft;
+        }
+    }
+    if (left <= Clock::duration::zero())
+    {
+        return 0;
+    }
+    return int(std::chrono::duration_cast<std::chrono::milliseconds>(left + std::chrono::milliseconds(1)).count());
+    //내림 때문에 조금 일찍 깨지 않도록 1ms 여유
+}
@@ -0,0 +1,70 @@
+#ifndef CHESSCLOCK_H
+#define CHESSCLOCK_H
+
+#include <chrono>
+#include "piece.h"
+
+//양쪽의 남은 시간을 관리하는 체스 시계,Qt에 의존하지 않음
+//마지막으로 시계를 누른 시각과 그때 남은 시간만 저장하고 현재 남은 시간은 물을때 계산
+//주기적으로 시간을 빼지 않으므로 이벤트 루프가 늦어져도 오차가 쌓이지 않음
+//시간 단위는 ms
+
+enum ClockMode
+{
+    FischerIncrement,//수를 두면 increment만큼 더함
+    BronsteinDelay,//수를 두면 사용한 시간 중 increment까지 돌려줌
+    SimpleDelay//매 수마다 increment 동안은 시계가 줄지 않음
+};
+
+struct TimeControl
+{
+    int initialMs = 600000;
+    int incrementMs = 0;//모드에 따라 증가 시간이나 지연 시간
+    ClockMode mode = FischerIncrement;
+};
+
+class ChessClock
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ChessClock(int initialMs = 600000);
+
+    void reset(int initialMs);//양쪽 시간을 처음으로 되돌리고 멈춤
+    void reset(const TimeControl& timeControl);
+    const TimeControl& timeControl() const
+    {
+        return control;
+    }
+
+    void press(Color mover, Clock::time_point now = Clock::now());
+    //mover가 수를 마치고 시계를 누름,증가/지연 시간을 반영하고 상대 시계를 시작
+    void stop(Clock::time_point now = Clock::now());//양쪽 시계를 멈춤,게임이 끝났을때
+    bool running() const
+    {
+        return isRunning;
+    }
+    Color runningSide() const
+    {
+        return side;
+    }
+
+    int remaining(Color color, Clock::time_point now = Clock::now()) const;//0 아래로 내려가지 않음
+    bool flagged(Color color, Clock::time_point now = Clock::now()) const//시간을 모두 사용했는지
+    {
+        return remaining(color, now) <= 0;
+    }
+    int msUntilFlag(Clock::time_point now = Clock::now()) const;
+    //움직이는 쪽의 시간이 다 떨어질때까지 남은 시간,멈춰 있으면 -1
+
+private:
+    Clock::duration used(Clock::time_point now) const;//이번 차례에 시계에서 빠진 시간
+
+    TimeControl control;
+    Clock::duration banked[2];//마지막으로 시계를 눌렀을때 남은 시간
+    Clock::time_point turnStart;
+    Color side = White;
+    bool isRunning = false;
+};
+
+#endif // CHESSCLOCK_H
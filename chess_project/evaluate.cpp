@@ -0,0 +1,205 @@
+#include "evaluate.h"
+#include "attacks.h"
+#include "tables.h"
+
+static const Score MobilityBonus[7] = { { 0, 0 }, { 4, 4 }, { 5, 5 }, { 2, 4 }, { 1, 2 }, { 0, 0 }, { 0, 0 } };
+//공격 가능한 칸 하나당 점수,PieceType 순서
+static const int MobilityBase[7] = { 0, 4, 6, 6, 13, 0, 0 };//이보다 적게 움직이면 감점
+static const int KingAttackWeight[7] = { 0, 2, 2, 3, 5, 0, 0 };//상대 킹 주변 칸 하나를 공격할때의 위험도
+static const int PawnShieldBonus = 10;//킹 앞 두 랭크의 자기 폰 하나당 중반 점수
+static const int OpenFileNearKing = 15;//킹 주변 파일에 자기 폰이 없을때 중반 감점
+static const Score PassedBonus[8] = { { 0, 0 }, { 5, 10 }, { 10, 17 }, { 15, 25 },
+                                      { 35, 50 }, { 70, 110 }, { 110, 170 }, { 0, 0 } };
+//통과한 폰의 상대 랭크별 점수
+static const Score IsolatedPenalty = { 5, 15 };
+static const Score DoubledPenalty = { 11, 40 };//같은 파일 앞쪽에 자기 폰이 있는 폰
+static const Score BackwardPenalty = { 9, 20 };//옆 파일 폰의 지원을 받을 수 없고 앞 칸이 공격받는 폰
+
+static Bitboard adjacentFiles(int file)
+{
+    Bitboard files = 0;
+    if (file > 0)
+    {
+        files |= FileABB << (file - 1);
+    }
+    if (file < 7)
+    {
+        files |= FileABB << (file + 1);
+    }
+    return files;
+}
+
+static Score evaluatePawns(const Board& board, Color us)
+{
+    Color them = Color(us ^ 1);
+    Bitboard ourPawns = board.pieces(us, Pawn);
+    Bitboard theirPawns = board.pieces(them, Pawn);
+    Direction forward = us == White ? North : South;
+
+    Score score = { 0, 0 };
+    Bitboard pawns = ourPawns;
+    while (pawns)
+    {
+        int sq = popLsb(pawns);
+        int file = fileOf(sq);
+        int relativeRank = us == White ? rankOf(sq) : 7 - rankOf(sq);
+        Bitboard neighbours = adjacentFiles(file);
+        Bitboard front = Rays[forward][sq];
+        Bitboard frontSpan = ((front << 1) & ~FileABB) | ((front >> 1) & ~FileHBB);
+        Bitboard levelOrBehind = us == White ? ~Bitboard(0) >> (8 * (7 - rankOf(sq)))
+                                             : ~Bitboard(0) << (8 * rankOf(sq));
+
+        if (!(theirPawns & (front | frontSpan)))
+        {
+            score += PassedBonus[relativeRank];
+        }
+        if (ourPawns & front)
+        {
+            score -= DoubledPenalty;
+        }
+        if (!(ourPawns & neighbours))
+        {
+            score -= IsolatedPenalty;
+        }
+        else if (!(ourPawns & neighbours & levelOrBehind))
+        {//앞 칸이 상대 폰에게 공격받으면 전진할 수도 지킬 수도 없음
+            int stop = us == White ? sq + 8 : sq - 8;
+            if (stop >= 0 && stop < 64 && (PawnAttacks[us][stop] & theirPawns))
+            {
+                score -= BackwardPenalty;
+            }
+        }
+    }
+    return score;
+}
+
+static int evaluateShelter(const Board& board, Color us, int kingSquare)
+{
+    Bitboard ourPawns = board.pieces(us, Pawn);
+    Bitboard front = KingAttacks[kingSquare] | squareBit(kingSquare);
+    front = us == White ? front << 8 : front >> 8;
+    Bitboard shield = front | (us == White ? front << 8 : front >> 8);
+    int shieldPawns = popCount(shield & ourPawns);
+    int shelter = PawnShieldBonus * (shieldPawns < 3 ? shieldPawns : 3);
+
+    int kingFile = fileOf(kingSquare);
+    for (int file = kingFile > 0 ? kingFile - 1 : 0; file <= (kingFile < 7 ? kingFile + 1 : 7); ++file)
+    {
+        if (!(ourPawns & (FileABB << file)))
+        {
+            shelter -= OpenFileNearKing;
+        }
+    }
+    return shelter;
+}
+
+static void updateShelter(const Board& board, PawnEntry& entry)
+{
+    for (int color = White; color <= Black; ++color)
+    {
+        int kingSquare = board.kingSquare(Color(color));
+        if (entry.kingSquare[color] != kingSquare)
+        {
+            entry.kingSquare[color] = kingSquare;
+            entry.shelter[color] = evaluateShelter(board, Color(color), kingSquare);
+        }
+    }
+}
+
+PawnTable::PawnTable()
+{
+    clear();
+}
+
+void PawnTable::clear()
+{
+    for (PawnEntry& entry : entries)
+    {
+        entry.key = 0;
+        entry.score = Score{ 0, 0 };
+        entry.kingSquare[White] = NoSquare;
+        entry.kingSquare[Black] = NoSquare;
+        entry.shelter[White] = 0;
+        entry.shelter[Black] = 0;
+    }
+    entries[0].key = ~uint64_t(0);//폰이 없는 국면의 키 0과 구별
+}
+
+PawnEntry* PawnTable::probe(const Board& board)
+{
+    uint64_t key = board.pawnKey();
+    PawnEntry* entry = &entries[key & (Size - 1)];
+    if (entry->key != key)
+    {
+        entry->key = key;
+        entry->score = evaluatePawns(board, White) - evaluatePawns(board, Black);
+        entry->kingSquare[White] = NoSquare;
+        entry->kingSquare[Black] = NoSquare;
+    }
+    updateShelter(board, *entry);
+    return entry;
+}
+
+static Score evaluatePieces(const Board& board, Color us)
+//us 쪽 기물의 기동력과 상대 킹 공격
+{
+    Color them = Color(us ^ 1);
+    Bitboard occupied = board.occupied();
+    Bitboard mobilityArea = ~board.pieces(us) & ~pawnAttacksOf(them, board.pieces(them, Pawn));
+    //상대 폰이 지키는 칸은 실제로 쓸 수 없으므로 제외
+    int theirKing = board.kingSquare(them);
+    Bitboard kingZone = KingAttacks[theirKing] | squareBit(theirKing);
+
+    Score score = { 0, 0 };
+    int kingAttackers = 0;
+    int kingDanger = 0;
+    for (int type = Knight; type <= Queen; ++type)
+    {
+        Bitboard bb = board.pieces(us, PieceType(type));
+        while (bb)
+        {
+            int sq = popLsb(bb);
+            Bitboard attacks = type == Knight ? KnightAttacks[sq]
+                               : type == Bishop ? bishopAttacks(sq, occupied)
+                               : type == Rook ? rookAttacks(sq, occupied)
+                                              : queenAttacks(sq, occupied);
+            score += MobilityBonus[type] * (popCount(attacks & mobilityArea) - MobilityBase[type]);
+            if (attacks & kingZone)
+            {
+                ++kingAttackers;
+                kingDanger += KingAttackWeight[type] * popCount(attacks & kingZone);
+            }
+        }
+    }
+    if (kingAttackers >= 2)
+    {//기물 하나의 공격은 쉽게 막히므로 둘 이상 모였을때만 위험으로 봄
+        int attackBonus = kingDanger * kingDanger / 4;
+        score.mg += attackBonus < 400 ? attackBonus : 400;
+    }
+    return score;
+}
+
+static int evaluate(const Board& board, const PawnEntry& pawns)
+{
+    Score score = board.psqScore() + pawns.score + evaluatePieces(board, White) - evaluatePieces(board, Black);
+    score.mg += pawns.shelter[White] - pawns.shelter[Black];
+    int phase = board.gamePhase() < MaxPhase ? board.gamePhase() : MaxPhase;//프로모션으로 넘을 수 있음
+    int value = (score.mg * phase + score.eg * (MaxPhase - phase)) / MaxPhase;
+    return board.sideToMove() == White ? value : -value;
+}
+
+int evaluate(const Board& board, PawnTable& pawnTable)
+{
+    return evaluate(board, *pawnTable.probe(board));
+}
+
+int evaluate(const Board& board)
+{
+    PawnEntry pawns;
+    pawns.key = board.pawnKey();
+    pawns.score = evaluatePawns(board, White) - evaluatePawns(board, Black);
+    pawns.kingSquare[White] = NoSquare;
+    pawns.kingSquare[Black] = NoSquare;
+    updateShelter(board, pawns);
+    return evaluate(board, pawns);
+}
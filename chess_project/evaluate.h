@@ -0,0 +1,36 @@
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "board.h"
+
+//탐색에서 사용하는 정적 평가,점수는 센티폰 단위이며 두는 쪽 기준
+//기물 가치와 칸 점수는 보드가 수를 둘때 갱신한 값을 쓰고,여기서는 기동력과 킹 안전도만 계산한다
+//중반 점수와 종반 점수를 게임 단계에 따라 섞음
+
+struct PawnEntry
+//폰 키 하나에 대한 폰 구조 평가,킹 앞 폰 방패는 킹 칸이 바뀔때만 다시 계산
+{
+    uint64_t key;
+    Score score;//통과한 폰,고립,겹친,뒤처진 폰,백 기준
+    int kingSquare[2];//shelter를 계산한 킹 칸,NoSquare면 아직 계산하지 않음
+    int shelter[2];//중반 점수,각 색 기준
+};
+
+class PawnTable
+//탐색 스레드마다 하나씩 가지는 작은 폰 구조 캐시,잠금이 필요없음
+{
+public:
+    static const int Size = 8192;//2의 거듭제곱
+
+    PawnTable();
+    void clear();
+    PawnEntry* probe(const Board& board);//폰 키에 맞는 항목,없으면 계산해서 채움
+
+private:
+    PawnEntry entries[Size];
+};
+
+int evaluate(const Board& board, PawnTable& pawnTable);
+int evaluate(const Board& board);//캐시 없이 평가,탐색 밖에서 한번씩 쓸때
+
+#endif // EVALUATE_H
@@ -1,9 +1,11 @@
 #include "chess.h"
+#include "attacks.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
+    initAttacks();//슬라이딩 기물 공격 표 생성
     QApplication a(argc, argv);
     chess w;
     w.show();
@@ -0,0 +1,138 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+#include <string>
+#include "piece.h"
+
+//수 하나와 고정 크기 수 목록
+
+enum MoveFlag
+{
+    NormalMove,
+    PromotionMove,
+    EnPassantMove,
+    CastlingMove//킹의 이동으로 표현,룩은 makeMove에서 함께 옮김
+};
+
+struct Move
+//16비트로 압축한 수
+//0~5비트 출발칸,6~11비트 도착칸,12~13비트 프로모션 기물(나이트~퀸),14~15비트 MoveFlag
+{
+    uint16_t data = 0;//0은 a1a1로 수가 없음을 뜻함
+
+    Move() = default;
+    constexpr Move(int fromSquare, int toSquare, MoveFlag moveFlag = NormalMove, PieceType promotionType = Knight)
+        : data(uint16_t(fromSquare | (toSquare << 6) | ((promotionType - Knight) << 12) | (moveFlag << 14)))
+    {
+    }
+
+    static constexpr Move fromRaw(uint16_t raw)//저장하거나 전송한 값에서 복원
+    {
+        Move move;
+        move.data = raw;
+        return move;
+    }
+    constexpr uint16_t raw() const
+    {
+        return data;
+    }
+
+    constexpr int from() const
+    {
+        return data & 0x3F;
+    }
+    constexpr int to() const
+    {
+        return (data >> 6) & 0x3F;
+    }
+    constexpr PieceType promotionType() const
+    {
+        return PieceType(((data >> 12) & 3) + Knight);
+    }
+    constexpr MoveFlag moveFlag() const
+    {
+        return MoveFlag(data >> 14);
+    }
+    constexpr bool isNone() const
+    {
+        return data == 0;
+    }
+    constexpr bool operator==(const Move& other) const
+    {
+        return data == other.data;
+    }
+    constexpr bool operator!=(const Move& other) const
+    {
+        return data != other.data;
+    }
+};
+static_assert(sizeof(Move) == 2, "Move must stay 16 bits");
+
+inline std::string moveToString(const Move& move)//e2e4,e7e8q 같은 좌표 표기
+{
+    std::string text;
+    text += char('a' + (move.from() & 7));
+    text += char('1' + (move.from() >> 3));
+    text += char('a' + (move.to() & 7));
+    text += char('1' + (move.to() >> 3));
+    if (move.moveFlag() == PromotionMove)
+    {
+        text += "pnbrqk"[move.promotionType()];
+    }
+    return text;
+}
+
+class MoveList
+//힙을 사용하지 않는 수 목록,한 국면의 합법수는 218개를 넘지 않음
+{
+public:
+    static const int Capacity = 256;
+
+    void add(const Move& move)
+    {
+        moves[count++] = move;
+    }
+    void clear()
+    {
+        count = 0;
+    }
+    int size() const
+    {
+        return count;
+    }
+    bool empty() const
+    {
+        return count == 0;
+    }
+    Move& operator[](int index)//정렬을 위해 순서를 바꿀 수 있음
+    {
+        return moves[index];
+    }
+    const Move& operator[](int index) const
+    {
+        return moves[index];
+    }
+    Move* begin()
+    {
+        return moves;
+    }
+    Move* end()
+    {
+        return moves + count;
+    }
+    const Move* begin() const
+    {
+        return moves;
+    }
+    const Move* end() const
+    {
+        return moves + count;
+    }
+
+private:
+    Move moves[Capacity];
+    int count = 0;
+};
+
+#endif // MOVE_H
@@ -0,0 +1,192 @@
+#include "movegen.h"
+#include "attacks.h"
+#include "tables.h"
+
+static void addPawnMoves(MoveList& list, int from, int to)
+//마지막 랭크에 도착하면 네가지 프로모션을 모두 추가
+{
+    if (rankOf(to) == 7 || rankOf(to) == 0)
+    {
+        list.add(Move(from, to, PromotionMove, Queen));
+        list.add(Move(from, to, PromotionMove, Rook));
+        list.add(Move(from, to, PromotionMove, Bishop));
+        list.add(Move(from, to, PromotionMove, Knight));
+    }
+    else
+    {
+        list.add(Move(from, to));
+    }
+}
+
+static void addPieceMoves(MoveList& list, int from, Bitboard targets)
+{
+    while (targets)
+    {
+        list.add(Move(from, popLsb(targets)));
+    }
+}
+
+void generateLegalMoves(const Board& board, MoveList& list, GenType type)
+{
+    list.clear();
+
+    Color us = board.sideToMove();
+    Color them = Color(us ^ 1);
+    Bitboard ours = board.pieces(us);
+    Bitboard theirs = board.pieces(them);
+    Bitboard occupied = board.occupied();
+    int kingSq = board.kingSquare(us);
+    Bitboard genMask = type == Captures ? theirs : type == Quiets ? ~occupied : ~ours;
+    //생성할 수의 도착칸
+
+    Bitboard theirRooks = board.pieces(them, Rook) | board.pieces(them, Queen);
+    Bitboard theirBishops = board.pieces(them, Bishop) | board.pieces(them, Queen);
+    Bitboard checkers = board.attackersTo(kingSq, occupied) & theirs;
+
+    //킹이 갈 수 없는 칸,킹을 뺀 점유 상태로 계산해야 슬라이딩 기물 반대편으로 피하는 수를 막을 수 있음
+    Bitboard withoutKing = occupied ^ squareBit(kingSq);
+    Bitboard danger = pawnAttacksOf(them, board.pieces(them, Pawn)) | KingAttacks[board.kingSquare(them)];
+    for (Bitboard b = board.pieces(them, Knight); b;)
+    {
+        danger |= KnightAttacks[popLsb(b)];
+    }
+    for (Bitboard b = theirBishops; b;)
+    {
+        danger |= bishopAttacks(popLsb(b), withoutKing);
+    }
+    for (Bitboard b = theirRooks; b;)
+    {
+        danger |= rookAttacks(popLsb(b), withoutKing);
+    }
+
+    addPieceMoves(list, kingSq, KingAttacks[kingSq] & genMask & ~danger);
+
+    if (popCount(checkers) > 1)
+    {
+        return;//이중 체크는 킹만 움직일 수 있음
+    }
+
+    Bitboard checkMask = ~Bitboard(0);
+    if (checkers)
+    {//체크를 건 기물을 잡거나 사이를 막는 칸으로만 이동 가능
+        checkMask = BetweenBB[kingSq][lsb(checkers)] | checkers;
+    }
+
+    //킹과 상대 슬라이딩 기물 사이에 우리 기물이 하나만 있으면 그 기물은 핀
+    Bitboard pinned = board.pinned(us);
+
+    Bitboard targets = genMask & checkMask;
+
+    for (Bitboard b = board.pieces(us, Knight) & ~pinned; b;)
+    {//핀된 나이트는 움직일 수 없음
+        int from = popLsb(b);
+        addPieceMoves(list, from, KnightAttacks[from] & targets);
+    }
+    for (Bitboard b = board.pieces(us, Bishop) | board.pieces(us, Queen); b;)
+    {
+        int from = popLsb(b);
+        Bitboard moves = bishopAttacks(from, occupied) & targets;
+        if (pinned & squareBit(from))
+        {
+            moves &= LineBB[kingSq][from];//핀된 기물은 핀 직선 위로만 이동
+        }
+        addPieceMoves(list, from, moves);
+    }
+    for (Bitboard b = board.pieces(us, Rook) | board.pieces(us, Queen); b;)
+    {
+        int from = popLsb(b);
+        Bitboard moves = rookAttacks(from, occupied) & targets;
+        if (pinned & squareBit(from))
+        {
+            moves &= LineBB[kingSq][from];
+        }
+        addPieceMoves(list, from, moves);
+    }
+
+    int up = us == White ? 8 : -8;
+    int startRank = us == White ? 1 : 6;
+    int ep = board.epSquare();
+    for (Bitboard b = board.pieces(us, Pawn); b;)
+    {
+        int from = popLsb(b);
+        Bitboard pinMask = (pinned & squareBit(from)) ? LineBB[kingSq][from] : ~Bitboard(0);
+        Bitboard allowed = checkMask & pinMask;
+
+        int to = from + up;
+        bool promotion = rankOf(to) == 7 || rankOf(to) == 0;
+        if (board.isEmpty(to) && type != (promotion ? Quiets : Captures))
+        {//잡지 않는 프로모션은 Captures에 포함
+            if (allowed & squareBit(to))
+            {
+                addPawnMoves(list, from, to);
+            }
+            if (rankOf(from) == startRank && board.isEmpty(to + up) && (allowed & squareBit(to + up)))
+            {
+                list.add(Move(from, to + up));
+            }
+        }
+
+        if (type == Quiets)
+        {
+            continue;
+        }
+        for (Bitboard captures = PawnAttacks[us][from] & theirs & allowed; captures;)
+        {
+            addPawnMoves(list, from, popLsb(captures));
+        }
+
+        if (ep != NoSquare && (PawnAttacks[us][from] & squareBit(ep)))
+        {//앙파상은 두 폰이 한꺼번에 사라지므로 이동 후 점유 상태로 직접 검사
+            int capturedSq = ep - up;
+            Bitboard after = (occupied ^ squareBit(from) ^ squareBit(capturedSq)) | squareBit(ep);
+            bool exposed = (rookAttacks(kingSq, after) & theirRooks) || (bishopAttacks(kingSq, after) & theirBishops);
+            bool otherCheck = (checkers & ~squareBit(capturedSq) & (board.pieces(them, Knight) | board.pieces(them, Pawn))) != 0;
+            if (!exposed && !otherCheck)
+            {
+                list.add(Move(from, ep, EnPassantMove));
+            }
+        }
+    }
+
+    int base = us == White ? 0 : 56;//킹과 룩이 있는 랭크의 시작 칸
+    if (type == Captures || checkers || kingSq != base + 4)
+    {
+        return;//체크중이거나 킹이 처음 자리에 없으면 캐슬링 불가
+    }
+
+    int kingSide = us == White ? WhiteKingSide : BlackKingSide;
+    int queenSide = us == White ? WhiteQueenSide : BlackQueenSide;
+    Piece ourRook = makePiece(us, Rook);
+
+    if ((board.castlingRights() & kingSide) && board.pieceAt(base + 7) == ourRook
+        && !(occupied & (squareBit(base + 5) | squareBit(base + 6)))
+        && !(danger & (squareBit(base + 5) | squareBit(base + 6))))
+    {//킹이 지나가는 칸이 비어있고 공격받지 않아야 함
+        list.add(Move(base + 4, base + 6, CastlingMove));
+    }
+    if ((board.castlingRights() & queenSide) && board.pieceAt(base) == ourRook
+        && !(occupied & (squareBit(base + 1) | squareBit(base + 2) | squareBit(base + 3)))
+        && !(danger & (squareBit(base + 2) | squareBit(base + 3))))
+    {
+        list.add(Move(base + 4, base + 2, CastlingMove));
+    }
+}
+
+GameStatus gameStatus(const Board& board)
+{
+    MoveList list;
+    generateLegalMoves(board, list);
+    if (list.empty())
+    {
+        return board.inCheck() ? Checkmate : Stalemate;
+    }
+    if (board.isFiftyMoveDraw())
+    {//50수째에 체크메이트가 되었다면 체크메이트가 우선
+        return FiftyMoveDraw;
+    }
+    if (board.isThreefoldRepetition())
+    {
+        return RepetitionDraw;
+    }
+    return Playing;
+}
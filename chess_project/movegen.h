@@ -0,0 +1,29 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "board.h"
+
+//합법수 생성기
+//수를 두어보고 검사하는 대신 핀 마스크와 체크 회피 마스크로 처음부터 합법수만 만든다
+
+enum GameStatus
+{
+    Playing,
+    Checkmate,//현재 두는 쪽이 체크메이트 당함
+    Stalemate,
+    FiftyMoveDraw,
+    RepetitionDraw//같은 국면이 세번 나옴
+};
+
+enum GenType
+{
+    AllMoves,
+    Captures,//잡는 수,앙파상,모든 프로모션
+    Quiets//나머지 수,캐슬링 포함
+};
+
+void generateLegalMoves(const Board& board, MoveList& list, GenType type = AllMoves);
+//Captures와 Quiets를 합치면 AllMoves와 같음
+GameStatus gameStatus(const Board& board);
+
+#endif // MOVEGEN_H
@@ -0,0 +1,172 @@
+#include "movepick.h"
+#include "evaluate.h"
+#include <utility>
+
+MovePicker::MovePicker(const Board& board, Move ttMove, const Move* killers, Move counterMove,
+                       const ButterflyHistory& history)
+    : board(board), history(history), ttMove(ttMove)
+{
+    refutations[0] = killers[0];
+    refutations[1] = killers[1];
+    refutations[2] = counterMove;
+}
+
+MovePicker::MovePicker(const Board& board, Move ttMove, const ButterflyHistory& history)
+    : board(board), history(history), ttMove(ttMove), capturesOnly(true)
+{
+    if (!ttMove.isNone() && !isNoisy(board, ttMove))
+    {
+        this->ttMove = Move();//조용한 수는 정지 탐색에서 보지 않음
+    }
+}
+
+bool MovePicker::isNoisy(const Board& board, const Move& move)
+//Captures 단계에서 만들어지는 수인지
+{
+    return move.moveFlag() == PromotionMove || move.moveFlag() == EnPassantMove || !board.isEmpty(move.to());
+}
+
+void MovePicker::generateCaptures()
+{
+    generateLegalMoves(board, captures, Captures);
+    for (int i = 0; i < captures.size(); ++i)
+    {//비싼 기물을 싼 기물로 잡는 수부터
+        const Move& move = captures[i];
+        PieceType victim = move.moveFlag() == EnPassantMove ? Pawn : typeOf(board.pieceAt(move.to()));
+        captureScores[i] = PieceValue[victim] * 16 - typeOf(board.pieceAt(move.from()));
+        if (move.moveFlag() == PromotionMove)
+        {
+            captureScores[i] += PieceValue[move.promotionType()] * 16;
+        }
+    }
+}
+
+void MovePicker::generateQuiets()
+{
+    generateLegalMoves(board, quiets, Quiets);
+    for (int i = 0; i < quiets.size(); ++i)
+    {
+        quietScores[i] = history[board.sideToMove()][quiets[i].from()][quiets[i].to()];
+    }
+}
+
+bool MovePicker::isRefutation(const Move& move) const
+{
+    return move == refutations[0] || move == refutations[1] || move == refutations[2];
+}
+
+int MovePicker::pickBest(MoveList& list, int* scores, int from)
+//남은 수 중 점수가 가장 높은 수를 from 위치로 옮김,전체 정렬 대신 필요한 만큼만 선택
+{
+    int best = from;
+    for (int i = from + 1; i < list.size(); ++i)
+    {
+        if (scores[i] > scores[best])
+        {
+            best = i;
+        }
+    }
+    std::swap(list[from], list[best]);
+    std::swap(scores[from], scores[best]);
+    return from;
+}
+
+Move MovePicker::next()
+{
+    switch (stage)
+    {
+    case TTStage:
+        stage = CaptureInit;
+        if (!ttMove.isNone() && board.pseudoLegal(ttMove) && board.legal(ttMove))
+        {//치환표의 수는 다른 국면의 수일 수 있으므로 수를 만들지 않고 이 국면에서 둘 수 있는지만 확인
+            return ttMove;
+        }
+        ttMove = Move();
+        [[fallthrough]];
+
+    case CaptureInit:
+        generateCaptures();
+        current = 0;
+        stage = GoodCaptures;
+        [[fallthrough]];
+
+    case GoodCaptures:
+        while (current < captures.size())
+        {
+            Move move = captures[pickBest(captures, captureScores, current++)];
+            if (move == ttMove)
+            {
+                continue;
+            }
+            if (!capturesOnly && !board.seeGe(move, 0))
+            {//기물을 잃는 잡기는 마지막에
+                badCaptures.add(move);
+                continue;
+            }
+            return move;
+        }
+        if (capturesOnly)
+        {
+            stage = Done;
+            break;
+        }
+        current = 0;
+        stage = Refutations;
+        [[fallthrough]];
+
+    case Refutations:
+        while (current < 3)
+        {
+            Move move = refutations[current++];
+            if (move.isNone() || move == ttMove || isNoisy(board, move))
+            {
+                continue;
+            }
+            if (current == 2 && move == refutations[0])
+            {
+                continue;
+            }
+            if (current == 3 && (move == refutations[0] || move == refutations[1]))
+            {
+                continue;
+            }
+            if (board.pseudoLegal(move) && board.legal(move))
+            {
+                return move;
+            }
+        }
+        stage = QuietInit;
+        [[fallthrough]];
+
+    case QuietInit:
+        generateQuiets();//조용한 수는 이 단계에 도달했을때만 만듦
+        current = 0;
+        stage = QuietMoves;
+        [[fallthrough]];
+
+    case QuietMoves:
+        while (current < quiets.size())
+        {
+            Move move = quiets[pickBest(quiets, quietScores, current++)];
+            if (move != ttMove && !isRefutation(move))
+            {
+                return move;
+            }
+        }
+        current = 0;
+        stage = BadCaptures;
+        [[fallthrough]];
+
+    case BadCaptures:
+        if (current < badCaptures.size())
+        {
+            return badCaptures[current++];
+        }
+        stage = Done;
+        [[fallthrough]];
+
+    case Done:
+        break;
+    }
+    return Move();
+}
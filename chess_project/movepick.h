@@ -0,0 +1,56 @@
+#ifndef MOVEPICK_H
+#define MOVEPICK_H
+
+#include "board.h"
+#include "movegen.h"
+
+//탐색에서 사용하는 단계별 수 선택기
+//치환표 수,좋은 잡기(MVV-LVA 순),킬러,카운터 수,조용한 수(히스토리 순),나쁜 잡기 순서로 돌려준다
+//앞 단계에서 컷오프가 나면 뒤 단계의 수는 만들지 않는다
+
+using ButterflyHistory = int[2][64][64];//[색][출발칸][도착칸]
+
+class MovePicker
+{
+public:
+    MovePicker(const Board& board, Move ttMove, const Move* killers, Move counterMove, const ButterflyHistory& history);
+    MovePicker(const Board& board, Move ttMove, const ButterflyHistory& history);
+    //정지 탐색용,잡는 수와 프로모션만 MVV-LVA 순으로 돌려주고 교환 손해 판단은 호출한 쪽에서 함
+
+    Move next();//다음으로 탐색할 수,남은 수가 없으면 isNone
+
+private:
+    enum Stage
+    {
+        TTStage,
+        CaptureInit,
+        GoodCaptures,
+        Refutations,//킬러 두개와 카운터 수
+        QuietInit,
+        QuietMoves,
+        BadCaptures,
+        Done
+    };
+
+    static bool isNoisy(const Board& board, const Move& move);
+    void generateCaptures();
+    void generateQuiets();
+    bool isRefutation(const Move& move) const;
+    int pickBest(MoveList& list, int* scores, int from);
+
+    const Board& board;
+    const ButterflyHistory& history;
+    Move ttMove;
+    Move refutations[3];
+    Stage stage = TTStage;
+
+    MoveList captures;
+    MoveList quiets;
+    MoveList badCaptures;
+    int captureScores[MoveList::Capacity];
+    int quietScores[MoveList::Capacity];
+    bool capturesOnly = false;
+    int current = 0;
+};
+
+#endif // MOVEPICK_H
@@ -0,0 +1,726 @@
+#include "nnue.h"
+#include <cstdlib>
+#include <cstring>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define CHESS_X86_64
+#endif
+#if defined(_MSC_VER) && defined(CHESS_X86_64)
+#include <intrin.h>
+#endif
+
+#if defined(CHESS_X86_64) && defined(__GNUC__)
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+const uint32_t NnueVersion = 0x7AF32F16;//Stockfish 12 신경망 파일 버전
+const int PieceSquareEnd = 10 * 64 + 1;//킹 칸 하나당 입력 수,0번은 사용하지 않음
+const int InputDimensions = 64 * PieceSquareEnd;
+const int TransformedDimensions = 2 * NnueHalfDimensions;
+const int HiddenDimensions = 32;
+const int WeightScaleBits = 6;//은닉층 출력의 고정소수점 자리수
+const int OutputScale = 16;//출력을 Stockfish 내부 점수로 바꾸는 값
+const int PawnValueEg = 208;//Stockfish 내부 점수의 폰 가치,센티폰으로 바꿀때 사용
+const int MaxEvaluation = 10000;
+
+struct Network
+{
+    alignas(64) int16_t ftBiases[NnueHalfDimensions];
+    const int16_t* ftWeights;//[입력][뉴런],매핑된 파일을 직접 가리키거나 정렬된 복사본
+    alignas(64) int32_t l1Biases[HiddenDimensions];
+    alignas(64) int8_t l1Weights[HiddenDimensions * TransformedDimensions];//[출력][입력]
+    alignas(64) int32_t l2Biases[HiddenDimensions];
+    alignas(64) int8_t l2Weights[HiddenDimensions * HiddenDimensions];
+    alignas(64) int32_t outBias[1];
+    alignas(64) int8_t outWeights[HiddenDimensions];
+};
+
+struct MappedFile
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+struct Kernels
+{
+    void (*updateRows)(int16_t* out, const int16_t* in, const int16_t* const* added, int addedCount,
+                       const int16_t* const* removed, int removedCount);
+    //out = in + added 행들의 합 - removed 행들의 합,in과 out은 같아도 됨
+    void (*transform)(const int16_t* accumulator, uint8_t* output);//누산기를 0~127로 자름
+    void (*affine)(const uint8_t* input, int inputDimensions, const int8_t* weights, const int32_t* biases,
+                   int outputDimensions, int32_t* output);
+};
+
+static Network* network = nullptr;
+static MappedFile networkFile;
+static int16_t* ftWeightsCopy = nullptr;//파일의 가중치가 정렬되어 있지 않을때만 사용
+static Kernels kernels;
+static NnueSimd activeSimd = SimdScalar;
+static bool simdChosen = false;
+
+static void updateRowsScalar(int16_t* out, const int16_t* in, const int16_t* const* added, int addedCount,
+                             const int16_t* const* removed, int removedCount)
+{
+    for (int i = 0; i < NnueHalfDimensions; ++i)
+    {
+        int value = in[i];
+        for (int r = 0; r < addedCount; ++r)
+        {
+            value += added[r][i];
+        }
+        for (int r = 0; r < removedCount; ++r)
+        {
+            value -= removed[r][i];
+        }
+        out[i] = int16_t(value);
+    }
+}
+
+static void transformScalar(const int16_t* accumulator, uint8_t* output)
+{
+    for (int i = 0; i < NnueHalfDimensions; ++i)
+    {
+        int value = accumulator[i];
+        output[i] = uint8_t(value < 0 ? 0 : value > 127 ? 127 : value);
+    }
+}
+
+static void affineScalar(const uint8_t* input, int inputDimensions, const int8_t* weights, const int32_t* biases,
+                         int outputDimensions, int32_t* output)
+{
+    for (int o = 0; o < outputDimensions; ++o)
+    {
+        const int8_t* row = weights + o * inputDimensions;
+        int32_t sum = biases[o];
+        for (int i = 0; i < inputDimensions; ++i)
+        {
+            sum += int32_t(input[i]) * row[i];
+        }
+        output[o] = sum;
+    }
+}
+
+#if defined(CHESS_X86_64)
+TARGET_SSE41
+static void updateRowsSse41(int16_t* out, const int16_t* in, const int16_t* const* added, int addedCount,
+                            const int16_t* const* removed, int removedCount)
+{
+    for (int i = 0; i < NnueHalfDimensions; i += 8)
+    {
+        __m128i value = _mm_load_si128(reinterpret_cast<const __m128i*>(in + i));
+        for (int r = 0; r < addedCount; ++r)
+        {
+            value = _mm_add_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(added[r] + i)));
+        }
+        for (int r = 0; r < removedCount; ++r)
+        {
+            value = _mm_sub_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(removed[r] + i)));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(out + i), value);
+    }
+}
+
+TARGET_SSE41
+static void transformSse41(const int16_t* accumulator, uint8_t* output)
+{
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < NnueHalfDimensions; i += 16)
+    {//포화 변환으로 -128~127로 줄인 뒤 음수를 0으로
+        __m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+        __m128i high = _mm_load_si128(reinterpret_cast<const __m128i*>(accumulator + i + 8));
+        __m128i packed = _mm_max_epi8(_mm_packs_epi16(low, high), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+}
+
+TARGET_SSE41
+static void affineSse41(const uint8_t* input, int inputDimensions, const int8_t* weights, const int32_t* biases,
+                        int outputDimensions, int32_t* output)
+//입력은 0~127이라 maddubs의 16비트 합이 포화되지 않음
+{
+    const __m128i ones = _mm_set1_epi16(1);
+    for (int o = 0; o < outputDimensions; ++o)
+    {
+        const int8_t* row = weights + o * inputDimensions;
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < inputDimensions; i += 16)
+        {
+            __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            __m128i w = _mm_load_si128(reinterpret_cast<const __m128i*>(row + i));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(in, w), ones));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+        output[o] = biases[o] + _mm_cvtsi128_si32(sum);
+    }
+}
+
+TARGET_AVX2
+static void updateRowsAvx2(int16_t* out, const int16_t* in, const int16_t* const* added, int addedCount,
+                           const int16_t* const* removed, int removedCount)
+{
+    for (int i = 0; i < NnueHalfDimensions; i += 16)
+    {
+        __m256i value = _mm256_load_si256(reinterpret_cast<const __m256i*>(in + i));
+        for (int r = 0; r < addedCount; ++r)
+        {
+            value = _mm256_add_epi16(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(added[r] + i)));
+        }
+        for (int r = 0; r < removedCount; ++r)
+        {
+            value = _mm256_sub_epi16(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(removed[r] + i)));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), value);
+    }
+}
+
+TARGET_AVX2
+static void transformAvx2(const int16_t* accumulator, uint8_t* output)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    for (int i = 0; i < NnueHalfDimensions; i += 32)
+    {
+        __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+        __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(accumulator + i + 16));
+        __m256i packed = _mm256_max_epi8(_mm256_packs_epi16(low, high), zero);
+        //packs는 128비트 단위로 섞이므로 64비트 묶음 순서를 되돌림
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+}
+
+TARGET_AVX2
+static void affineAvx2(const uint8_t* input, int inputDimensions, const int8_t* weights, const int32_t* biases,
+                       int outputDimensions, int32_t* output)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (int o = 0; o < outputDimensions; ++o)
+    {
+        const int8_t* row = weights + o * inputDimensions;
+        __m256i sum = _mm256_setzero_si256();
+        for (int i = 0; i < inputDimensions; i += 32)
+        {
+            __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(row + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(in, w), ones));
+        }
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+        output[o] = biases[o] + _mm_cvtsi128_si32(half);
+    }
+}
+#endif
+
+static bool cpuSupports(NnueSimd simd)
+{
+    if (simd == SimdScalar)
+    {
+        return true;
+    }
+#if defined(CHESS_X86_64) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return simd == SimdAvx2 ? __builtin_cpu_supports("avx2") != 0 : __builtin_cpu_supports("sse4.1") != 0;
+#elif defined(CHESS_X86_64) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;//운영체제가 AVX 레지스터를 저장해야 사용 가능
+    __cpuidex(info, 7, 0);
+    bool avx2 = osxsave && (info[1] & (1 << 5)) != 0;
+    return simd == SimdAvx2 ? avx2 : sse41;
+#else
+    return false;
+#endif
+}
+
+bool setNnueSimd(NnueSimd simd)
+{
+    if (!cpuSupports(simd))
+    {
+        return false;
+    }
+    kernels.updateRows = updateRowsScalar;
+    kernels.transform = transformScalar;
+    kernels.affine = affineScalar;
+#if defined(CHESS_X86_64)
+    if (simd == SimdSse41)
+    {
+        kernels.updateRows = updateRowsSse41;
+        kernels.transform = transformSse41;
+        kernels.affine = affineSse41;
+    }
+    else if (simd == SimdAvx2)
+    {
+        kernels.updateRows = updateRowsAvx2;
+        kernels.transform = transformAvx2;
+        kernels.affine = affineAvx2;
+    }
+#endif
+    activeSimd = simd;
+    simdChosen = true;
+    return true;
+}
+
+NnueSimd nnueSimd()
+{
+    if (!simdChosen)
+    {
+        if (!setNnueSimd(SimdAvx2) && !setNnueSimd(SimdSse41))
+        {
+            setNnueSimd(SimdScalar);
+        }
+    }
+    return activeSimd;
+}
+
+const char* nnueSimdName(NnueSimd simd)
+{
+    return simd == SimdAvx2 ? "avx2" : simd == SimdSse41 ? "sse4.1" : "scalar";
+}
+
+static bool mapFile(const std::string& path, MappedFile& file)
+//파일 전체를 읽기 전용으로 매핑,실제 읽기는 처음 접근할때 운영체제가 함
+{
+#if defined(_WIN32)
+    file.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file.file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file.file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file.file);
+        file.file = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    file.mapping = CreateFileMappingA(file.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = file.mapping ? MapViewOfFile(file.mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (file.mapping)
+        {
+            CloseHandle(file.mapping);
+        }
+        CloseHandle(file.file);
+        file = MappedFile();
+        return false;
+    }
+    file.data = static_cast<const uint8_t*>(view);
+    file.size = size_t(size.QuadPart);
+    return true;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);//매핑은 파일을 닫아도 유지됨
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+    file.data = static_cast<const uint8_t*>(view);
+    file.size = size_t(info.st_size);
+    return true;
+#endif
+}
+
+static void unmapFile(MappedFile& file)
+{
+    if (!file.data)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(file.data);
+    CloseHandle(file.mapping);
+    CloseHandle(file.file);
+#else
+    munmap(const_cast<uint8_t*>(file.data), file.size);
+#endif
+    file = MappedFile();
+}
+
+static int16_t* allocateWeights(size_t bytes)
+{
+    void* memory = nullptr;
+#if defined(_WIN32)
+    memory = _aligned_malloc(bytes, 64);
+#else
+    if (posix_memalign(&memory, 64, bytes) != 0)
+    {
+        memory = nullptr;
+    }
+#endif
+    return static_cast<int16_t*>(memory);
+}
+
+static void freeWeights(int16_t* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+class Reader
+//매핑된 파일을 앞에서부터 읽음,남은 크기보다 많이 읽으려 하면 실패 상태가 됨
+{
+public:
+    Reader(const uint8_t* data, size_t size)
+        : position(data), end(data + size)
+    {
+    }
+
+    const uint8_t* take(size_t bytes)
+    {
+        if (failed || size_t(end - position) < bytes)
+        {
+            failed = true;
+            return nullptr;
+        }
+        const uint8_t* start = position;
+        position += bytes;
+        return start;
+    }
+
+    bool read(void* destination, size_t bytes)
+    {
+        const uint8_t* source = take(bytes);
+        if (source)
+        {
+            std::memcpy(destination, source, bytes);
+        }
+        return source != nullptr;
+    }
+
+    uint32_t readU32()
+    {
+        uint32_t value = 0;
+        read(&value, sizeof(value));//파일은 리틀 엔디언
+        return value;
+    }
+
+    bool finished() const
+    {
+        return !failed && position == end;
+    }
+
+private:
+    const uint8_t* position;
+    const uint8_t* end;
+    bool failed = false;
+};
+
+bool loadNetwork(const std::string& path)
+{
+    nnueSimd();
+    MappedFile file;
+    if (!mapFile(path, file))
+    {
+        return false;
+    }
+
+    Network* loaded = new Network;
+    Reader reader(file.data, file.size);
+    bool valid = reader.readU32() == NnueVersion;
+    reader.readU32();//구조 해시,크기 검사로 충분하므로 확인하지 않음
+    reader.take(reader.readU32());//설명 문자열
+    reader.readU32();
+    reader.read(loaded->ftBiases, sizeof(loaded->ftBiases));
+    size_t ftBytes = size_t(InputDimensions) * NnueHalfDimensions * sizeof(int16_t);
+    const uint8_t* ftWeights = reader.take(ftBytes);
+    reader.readU32();
+    reader.read(loaded->l1Biases, sizeof(loaded->l1Biases));
+    reader.read(loaded->l1Weights, sizeof(loaded->l1Weights));
+    reader.read(loaded->l2Biases, sizeof(loaded->l2Biases));
+    reader.read(loaded->l2Weights, sizeof(loaded->l2Weights));
+    reader.read(loaded->outBias, sizeof(loaded->outBias));
+    reader.read(loaded->outWeights, sizeof(loaded->outWeights));
+    valid = valid && reader.finished();
+
+    int16_t* copy = nullptr;
+    if (valid)
+    {
+        if (reinterpret_cast<uintptr_t>(ftWeights) % 64 == 0)
+        {//정렬되어 있으면 복사하지 않고 매핑된 페이지를 그대로 사용
+            loaded->ftWeights = reinterpret_cast<const int16_t*>(ftWeights);
+        }
+        else
+        {
+            copy = allocateWeights(ftBytes);
+            valid = copy != nullptr;
+            if (copy)
+            {
+                std::memcpy(copy, ftWeights, ftBytes);
+                loaded->ftWeights = copy;
+            }
+        }
+    }
+    if (!valid)
+    {
+        delete loaded;
+        unmapFile(file);
+        return false;
+    }
+
+    unloadNetwork();
+    network = loaded;
+    ftWeightsCopy = copy;
+    if (copy)
+    {
+        unmapFile(file);
+    }
+    else
+    {
+        networkFile = file;
+    }
+    return true;
+}
+
+void unloadNetwork()
+{
+    delete network;
+    network = nullptr;
+    if (ftWeightsCopy)
+    {
+        freeWeights(ftWeightsCopy);
+        ftWeightsCopy = nullptr;
+    }
+    unmapFile(networkFile);
+}
+
+bool networkLoaded()
+{
+    return network != nullptr;
+}
+
+static int featureIndex(Color perspective, int kingSquare, Piece piece, int square)
+//흑 관점은 판을 180도 돌려서 같은 입력을 사용
+{
+    int flip = perspective == White ? 0 : 63;
+    int pieceIndex = 2 * typeOf(piece) + (colorOf(piece) != perspective);
+    return (kingSquare ^ flip) * PieceSquareEnd + 1 + pieceIndex * 64 + (square ^ flip);
+}
+
+static const int16_t* weightRow(int index)
+{
+    return network->ftWeights + size_t(index) * NnueHalfDimensions;
+}
+
+void NnueState::reset()
+{
+    top = 0;
+    stack[0].computed[White] = false;
+    stack[0].computed[Black] = false;
+}
+
+void NnueState::push(const Board& board, const Move& move)
+{
+    ++top;
+    stack[top].computed[White] = false;
+    stack[top].computed[Black] = false;
+    NnueDelta& delta = deltas[top];
+    delta.count = 0;
+    if (!network)
+    {
+        return;
+    }
+
+    auto record = [&delta](Piece piece, int from, int to)
+    {
+        delta.piece[delta.count] = piece;
+        delta.from[delta.count] = from;
+        delta.to[delta.count] = to;
+        ++delta.count;
+    };
+    int from = move.from();
+    int to = move.to();
+    Piece piece = board.pieceAt(from);
+    if (move.moveFlag() == CastlingMove)
+    {
+        bool kingSide = to > from;
+        int rookFrom = kingSide ? from + 3 : from - 4;
+        record(piece, from, to);
+        record(board.pieceAt(rookFrom), rookFrom, kingSide ? from + 1 : from - 1);
+    }
+    else if (move.moveFlag() == EnPassantMove)
+    {
+        int capturedSquare = colorOf(piece) == White ? to - 8 : to + 8;
+        record(board.pieceAt(capturedSquare), capturedSquare, NoSquare);
+        record(piece, from, to);
+    }
+    else
+    {
+        if (!board.isEmpty(to))
+        {
+            record(board.pieceAt(to), to, NoSquare);
+        }
+        if (move.moveFlag() == PromotionMove)
+        {
+            record(piece, from, NoSquare);
+            record(makePiece(colorOf(piece), move.promotionType()), NoSquare, to);
+        }
+        else
+        {
+            record(piece, from, to);
+        }
+    }
+}
+
+void NnueState::pushNull()
+{
+    ++top;
+    stack[top].computed[White] = false;
+    stack[top].computed[Black] = false;
+    deltas[top].count = 0;
+}
+
+void NnueState::pop()
+{
+    --top;
+}
+
+void NnueState::refresh(const Board& board, Color perspective, NnueAccumulator& accumulator)
+{
+    const int16_t* rows[32];
+    int count = 0;
+    const int16_t* source = network->ftBiases;
+    int kingSquare = board.kingSquare(perspective);
+    Bitboard pieces = board.occupied() & ~board.pieces(King);
+    while (pieces)
+    {
+        int square = popLsb(pieces);
+        rows[count++] = weightRow(featureIndex(perspective, kingSquare, board.pieceAt(square), square));
+        if (count == 32 && pieces)
+        {//FEN으로 만든 국면은 기물이 더 많을 수 있으므로 나눠서 더함
+            kernels.updateRows(accumulator.values[perspective], source, rows, count, nullptr, 0);
+            source = accumulator.values[perspective];
+            count = 0;
+        }
+    }
+    kernels.updateRows(accumulator.values[perspective], source, rows, count, nullptr, 0);
+    accumulator.computed[perspective] = true;
+}
+
+void NnueState::update(const Board& board, Color perspective)
+{
+    if (stack[top].computed[perspective])
+    {
+        return;
+    }
+
+    Piece ownKing = makePiece(perspective, King);
+    int computed = top;
+    while (!stack[computed].computed[perspective])
+    {//계산된 누산기를 찾아 거슬러 올라감,그 사이에 자기 킹이 움직였으면 모든 입력이 바뀜
+        const NnueDelta& delta = deltas[computed];
+        bool kingMoved = false;
+        for (int i = 0; i < delta.count; ++i)
+        {
+            kingMoved = kingMoved || delta.piece[i] == ownKing;
+        }
+        if (computed == 0 || kingMoved)
+        {
+            refresh(board, perspective, stack[top]);
+            return;
+        }
+        --computed;
+    }
+
+    int kingSquare = board.kingSquare(perspective);
+    for (int ply = computed + 1; ply <= top; ++ply)
+    {
+        const NnueDelta& delta = deltas[ply];
+        const int16_t* added[3];
+        const int16_t* removed[3];
+        int addedCount = 0;
+        int removedCount = 0;
+        for (int i = 0; i < delta.count; ++i)
+        {
+            if (typeOf(delta.piece[i]) == King)
+            {//상대 킹은 입력에 포함되지 않음
+                continue;
+            }
+            if (delta.from[i] != NoSquare)
+            {
+                removed[removedCount++] = weightRow(featureIndex(perspective, kingSquare, delta.piece[i], delta.from[i]));
+            }
+            if (delta.to[i] != NoSquare)
+            {
+                added[addedCount++] = weightRow(featureIndex(perspective, kingSquare, delta.piece[i], delta.to[i]));
+            }
+        }
+        kernels.updateRows(stack[ply].values[perspective], stack[ply - 1].values[perspective],
+                           added, addedCount, removed, removedCount);
+        stack[ply].computed[perspective] = true;
+    }
+}
+
+static void clippedRelu(const int32_t* input, uint8_t* output, int dimensions)
+{
+    for (int i = 0; i < dimensions; ++i)
+    {
+        int value = input[i] >> WeightScaleBits;
+        output[i] = uint8_t(value < 0 ? 0 : value > 127 ? 127 : value);
+    }
+}
+
+int NnueState::evaluate(const Board& board)
+{
+    update(board, White);
+    update(board, Black);
+    const NnueAccumulator& accumulator = stack[top];
+    Color us = board.sideToMove();
+
+    alignas(64) uint8_t transformed[TransformedDimensions];//두는 쪽 관점이 앞
+    kernels.transform(accumulator.values[us], transformed);
+    kernels.transform(accumulator.values[us ^ 1], transformed + NnueHalfDimensions);
+
+    alignas(64) int32_t sums[HiddenDimensions];
+    alignas(64) uint8_t hidden1[HiddenDimensions];
+    alignas(64) uint8_t hidden2[HiddenDimensions];
+    kernels.affine(transformed, TransformedDimensions, network->l1Weights, network->l1Biases, HiddenDimensions, sums);
+    clippedRelu(sums, hidden1, HiddenDimensions);
+    kernels.affine(hidden1, HiddenDimensions, network->l2Weights, network->l2Biases, HiddenDimensions, sums);
+    clippedRelu(sums, hidden2, HiddenDimensions);
+    int32_t output = 0;
+    kernels.affine(hidden2, HiddenDimensions, network->outWeights, network->outBias, 1, &output);
+
+    int value = output / OutputScale * 100 / PawnValueEg;
+    return value > MaxEvaluation ? MaxEvaluation : value < -MaxEvaluation ? -MaxEvaluation : value;
+}
@@ -0,0 +1,67 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include <string>
+#include "board.h"
+
+//효율적으로 갱신되는 신경망 평가(NNUE)
+//입력은 HalfKP(자기 킹 칸 x 킹 외 기물 칸),구조는 41024 -> 256x2 -> 32 -> 32 -> 1
+//가중치 파일은 Stockfish 12의 HalfKP 256x2-32-32 형식을 그대로 읽는다
+//신경망을 읽지 않았으면 탐색은 기존 평가를 사용
+
+const int NnueHalfDimensions = 256;//한 관점의 누산기 크기
+const int NnueStackSize = 256;//탐색 깊이별 누산기 개수,MaxPly보다 커야 함
+
+enum NnueSimd
+{
+    SimdScalar,
+    SimdSse41,
+    SimdAvx2
+};
+
+bool loadNetwork(const std::string& path);
+//파일을 메모리 매핑해서 신경망을 읽음,실패하면 이전 상태를 유지하고 false
+//탐색중에는 호출하지 않음
+void unloadNetwork();
+bool networkLoaded();
+NnueSimd nnueSimd();//현재 사용하는 SIMD 커널,처음 호출할때 CPU를 검사해서 가장 빠른 것을 고름
+bool setNnueSimd(NnueSimd simd);//커널을 직접 지정,CPU가 지원하지 않으면 false
+const char* nnueSimdName(NnueSimd simd);
+
+struct alignas(64) NnueAccumulator
+{
+    int16_t values[2][NnueHalfDimensions];//[관점][뉴런]
+    bool computed[2];
+};
+
+struct NnueDelta
+//수 하나로 바뀐 기물,from이나 to가 NoSquare이면 새로 놓이거나 빠진 기물
+{
+    int count;
+    Piece piece[3];
+    int from[3];
+    int to[3];
+};
+
+class NnueState
+//탐색 스레드 하나의 누산기 스택
+//수를 둘때는 바뀐 기물만 기록하고,평가할때 마지막으로 계산된 누산기에서 차이만 반영
+{
+public:
+    void reset();//새 루트 국면,첫 평가에서 처음부터 계산
+    void push(const Board& board, const Move& move);//board.makeMove 전에 호출
+    void pushNull();
+    void pop();//board.unmakeMove 후에 호출
+    int evaluate(const Board& board);//두는 쪽 기준 센티폰
+
+private:
+    void update(const Board& board, Color perspective);
+    void refresh(const Board& board, Color perspective, NnueAccumulator& accumulator);
+
+    NnueAccumulator stack[NnueStackSize];
+    NnueDelta deltas[NnueStackSize];
+    int top = 0;
+};
+
+#endif // NNUE_H
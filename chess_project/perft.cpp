@@ -0,0 +1,468 @@
+#include "movegen.h"
+#include "attacks.h"
+#include "search.h"
+#include "nnue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+//수 생성 속도 측정과 규칙 회귀 검사를 위한 perft 도구
+//사용법: chess_perft [-t 스레드수] [-H 해시MB] [-d 깊이] [--divide] [--full] [FEN]
+//FEN을 주지 않으면 표준 테스트 국면을 모두 검사하고 노드 수가 다르면 1을 반환
+//--bench는 같은 국면들을 고정 깊이로 탐색해서 노드 수와 속도를 출력,--no-null 등으로 가지치기를 하나씩 끄고 비교
+//--nnue로 신경망 파일을 주면 신경망 평가로 탐색,--simd로 커널을 바꿔 속도를 비교
+
+struct PerftPosition
+{
+    const char* name;
+    const char* fen;
+    int depth;//기본 검사 깊이
+    uint64_t nodes;
+    int fullDepth;//--full 사용시 깊이
+    uint64_t fullNodes;
+};
+
+static const PerftPosition suite[] = {
+    { "start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      5, 4865609ULL, 6, 119060324ULL },
+    { "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      4, 4085603ULL, 5, 193690690ULL },
+    { "position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      6, 11030083ULL, 7, 178633661ULL },
+    { "position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+      4, 422333ULL, 5, 15833292ULL },
+    { "position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+      4, 2103487ULL, 5, 89941194ULL },
+    { "position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+      4, 3894594ULL, 5, 164075551ULL },
+};
+
+static const char* const invalidFens[] = {
+    //setFen이 받지 않아야 하는 국면,받으면 수 생성이 보드 밖을 읽거나 킹을 잡음
+    "4k3/8/8/8/8/8/8/P3K3 w - - 0 1",//1랭크의 폰
+    "P3k3/8/8/8/8/8/8/4K3 w - - 0 1",//8랭크의 폰
+    "4k3/8/8/8/8/8/8/4K3 w K - 0 1",//룩 없는 캐슬링 권리
+    "r3k2r/8/8/8/8/8/8/R2K3R w Q - 0 1",//킹이 처음 자리에 없는 캐슬링 권리
+    "4k3/8/8/8/8/8/8/4K3 w - e6 0 1",//뒤에 폰이 없는 앙파상 칸
+    "4k3/8/8/3pP3/8/8/8/4K3 w - d5 0 1",//6랭크가 아닌 앙파상 칸
+    "4k3/8/8/3pP3/8/8/8/4K3 b - d6 0 1",//두는 쪽 폰이 지나간 앙파상 칸
+    "4k3/8/8/8/8/8/8/4K2r b - - 0 1",//두지 않는 쪽이 체크
+    "4k3/4R3/8/8/8/8/8/4K3 w - - 0 1",
+};
+
+class PerftHash
+//여러 스레드가 잠금없이 공유하는 perft 결과 캐시
+//키와 데이터를 XOR해서 저장하므로 두 값이 섞여 기록되면 검사에서 걸러짐
+{
+public:
+    explicit PerftHash(size_t megabytes)
+    {
+        size_t count = 1;
+        while (count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024)
+        {
+            count *= 2;
+        }
+        entries.reset(new Entry[count]);
+        mask = count - 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            entries[i].check.store(0, std::memory_order_relaxed);
+            entries[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool probe(uint64_t key, int depth, uint64_t& nodes) const
+    {
+        const Entry& entry = entries[key & mask];
+        uint64_t data = entry.data.load(std::memory_order_relaxed);
+        uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || int(data & 0xFF) != depth)
+        {
+            return false;
+        }
+        nodes = data >> 8;
+        return true;
+    }
+
+    void store(uint64_t key, int depth, uint64_t nodes)
+    {
+        Entry& entry = entries[key & mask];
+        uint64_t data = (nodes << 8) | uint64_t(depth);
+        entry.check.store(key ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry
+    {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    size_t mask = 0;
+};
+
+static uint64_t perft(Board& board, int depth, PerftHash* hash)
+{
+    MoveList list;
+    generateLegalMoves(board, list);
+    if (depth == 1)
+    {
+        return uint64_t(list.size());//마지막 깊이는 수를 두지 않고 개수만 셈
+    }
+
+    uint64_t key = 0;
+    uint64_t nodes = 0;
+    if (hash)
+    {
+        key = board.key();
+        if (hash->probe(key, depth, nodes))
+        {
+            return nodes;
+        }
+    }
+
+    for (const Move& move : list)
+    {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1, hash);
+        board.unmakeMove(move);
+    }
+
+    if (hash)
+    {
+        hash->store(key, depth, nodes);
+    }
+    return nodes;
+}
+
+static uint64_t runPerft(const Board& board, int depth, int threads, PerftHash* hash, bool divide)
+//첫 수들을 스레드들이 하나씩 가져가 병렬로 계산
+{
+    if (depth <= 0)
+    {
+        return 1;
+    }
+
+    MoveList rootMoves;
+    generateLegalMoves(board, rootMoves);
+    std::vector<uint64_t> counts(rootMoves.size(), 0);
+    std::atomic<int> next(0);
+
+    auto worker = [&]()
+    {
+        Board child = board;//스레드마다 자기 보드에서 두고 되돌림
+        for (int i = next++; i < rootMoves.size(); i = next++)
+        {
+            if (depth == 1)
+            {
+                counts[i] = 1;
+                continue;
+            }
+            child.makeMove(rootMoves[i]);
+            counts[i] = perft(child, depth - 1, hash);
+            child.unmakeMove(rootMoves[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();//현재 스레드도 함께 계산
+    for (std::thread& thread : pool)
+    {
+        thread.join();
+    }
+
+    uint64_t total = 0;
+    for (int i = 0; i < rootMoves.size(); ++i)
+    {
+        if (divide)
+        {
+            std::printf("%s: %llu\n", moveToString(rootMoves[i]).c_str(), (unsigned long long)counts[i]);
+        }
+        total += counts[i];
+    }
+    return total;
+}
+
+static uint64_t timedPerft(const Board& board, int depth, int threads, PerftHash* hash, bool divide, double& seconds)
+{
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nodes = runPerft(board, depth, threads, hash, divide);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return nodes;
+}
+
+static int runBench(const std::vector<std::string>& fens, int depth, int threads, size_t hashMb,
+                    const SearchOptions& options)
+//국면마다 해시를 비우고 고정 깊이로 탐색,노드 수가 같으면 탐색 결과도 같음
+{
+    Search search;
+    search.setThreads(threads);
+    if (!search.setHashSize(hashMb > 0 ? hashMb : 16))
+    {
+        std::fprintf(stderr, "warning: could not allocate %zu MB hash, using a smaller table\n", hashMb > 0 ? hashMb : 16);
+    }
+    search.setOptions(options);
+    std::printf("eval %s\n", networkLoaded() ? nnueSimdName(nnueSimd()) : "classical");
+    std::printf("bench depth %d  null %d  lmr %d  rfp %d  futility %d  aspiration %d\n",
+                depth, options.nullMove, options.lateMoveReductions, options.reverseFutility,
+                options.futility, options.aspiration);
+
+    uint64_t totalNodes = 0;
+    int totalMs = 0;
+    for (const std::string& fen : fens)
+    {
+        Board board;
+        if (!board.setFen(fen))
+        {
+            std::fprintf(stderr, "invalid fen: %s\n", fen.c_str());
+            return 2;
+        }
+        search.clearHash();
+        SearchLimits limits;
+        limits.maxDepth = depth;
+        SearchResult result = search.run(board, limits);
+        totalNodes += result.nodes;
+        totalMs += result.timeMs;
+
+        std::printf("%-6s score %6d  nodes %11llu  time %6dms  nps %10llu  hashfull %4d  |",
+                    moveToString(result.bestMove).c_str(), result.score,
+                    (unsigned long long)result.nodes, result.timeMs, (unsigned long long)result.nps(),
+                    result.hashfull);
+        for (uint64_t nodes : result.threadNodes)
+        {//스레드별 nps
+            std::printf(" %llu", (unsigned long long)(result.timeMs > 0 ? nodes * 1000 / uint64_t(result.timeMs) : nodes));
+        }
+        std::printf("\n");
+    }
+
+    std::printf("total  nodes %llu  time %dms  nps %llu\n", (unsigned long long)totalNodes, totalMs,
+                (unsigned long long)(totalMs > 0 ? totalNodes * 1000 / uint64_t(totalMs) : totalNodes));
+    return 0;
+}
+
+static void printUsage()
+{
+    std::printf("usage: chess_perft [-t threads] [-H hash_mb] [--divide] [--full]\n"
+                "       chess_perft [-t threads] [-H hash_mb] [-d depth] [--divide] fen\n"
+                "       chess_perft --bench [-t threads] [-H hash_mb] [-d depth] [--no-null] [--no-lmr]\n"
+                "                   [--no-rfp] [--no-futility] [--no-aspiration]\n"
+                "                   [--nnue file] [--simd scalar|sse41|avx2] [fen]\n");
+}
+
+int main(int argc, char* argv[])
+{
+    int threads = 0;//0이면 모드별 기본,벤치는 노드 수가 재현되도록 1,perft는 코어 수
+    size_t hashMb = 0;
+    int depth = 0;//0이면 모드별 기본 깊이
+    bool depthGiven = false;
+    bool divide = false;
+    bool full = false;
+    bool bench = false;
+    SearchOptions options;
+    std::string networkPath;
+    std::string simd;
+    std::string fen;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-t") && i + 1 < argc)
+        {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (!std::strcmp(argv[i], "-H") && i + 1 < argc)
+        {
+            hashMb = size_t(std::max(0, std::atoi(argv[++i])));
+        }
+        else if (!std::strcmp(argv[i], "-d") && i + 1 < argc)
+        {
+            depth = std::atoi(argv[++i]);
+            depthGiven = true;
+        }
+        else if (!std::strcmp(argv[i], "--divide"))
+        {
+            divide = true;
+        }
+        else if (!std::strcmp(argv[i], "--full"))
+        {
+            full = true;
+        }
+        else if (!std::strcmp(argv[i], "--bench"))
+        {
+            bench = true;
+        }
+        else if (!std::strcmp(argv[i], "--no-null"))
+        {
+            options.nullMove = false;
+        }
+        else if (!std::strcmp(argv[i], "--no-lmr"))
+        {
+            options.lateMoveReductions = false;
+        }
+        else if (!std::strcmp(argv[i], "--no-rfp"))
+        {
+            options.reverseFutility = false;
+        }
+        else if (!std::strcmp(argv[i], "--no-futility"))
+        {
+            options.futility = false;
+        }
+        else if (!std::strcmp(argv[i], "--no-aspiration"))
+        {
+            options.aspiration = false;
+        }
+        else if (!std::strcmp(argv[i], "--nnue") && i + 1 < argc)
+        {
+            networkPath = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--simd") && i + 1 < argc)
+        {
+            simd = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "-h") || !std::strcmp(argv[i], "--help"))
+        {
+            printUsage();
+            return 0;
+        }
+        else
+        {//나머지 인자는 FEN으로 이어붙임
+            if (!fen.empty())
+            {
+                fen += ' ';
+            }
+            fen += argv[i];
+        }
+    }
+
+    initAttacks();
+    if (bench)
+    {
+        if (!networkPath.empty() && !loadNetwork(networkPath))
+        {
+            std::fprintf(stderr, "cannot load network: %s\n", networkPath.c_str());
+            return 2;
+        }
+        if (!simd.empty())
+        {
+            NnueSimd level = simd == "avx2" ? SimdAvx2 : simd == "sse41" ? SimdSse41 : SimdScalar;
+            if (!setNnueSimd(level))
+            {
+                std::fprintf(stderr, "simd not supported: %s\n", simd.c_str());
+                return 2;
+            }
+        }
+        std::vector<std::string> fens;
+        if (!fen.empty())
+        {
+            fens.push_back(fen);
+        }
+        else
+        {
+            for (const PerftPosition& position : suite)
+            {
+                fens.push_back(position.fen);
+            }
+        }
+        return runBench(fens, depth > 0 ? depth : 10, threads > 0 ? threads : 1, hashMb, options);
+    }
+    if (fen.empty() && depthGiven)
+    {//검사 묶음은 국면마다 기대 노드 수가 정해진 깊이에만 있음
+        std::fprintf(stderr, "-d needs a fen, the suite uses its own depths (--full for the deeper set)\n");
+        printUsage();
+        return 2;
+    }
+    if (depth <= 0)
+    {
+        depth = 5;
+    }
+    if (threads <= 0)
+    {//perft는 스레드 수와 상관없이 노드 수가 같으므로 모든 코어 사용
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+
+    std::unique_ptr<PerftHash> hash;
+    if (hashMb > 0)
+    {
+        hash.reset(new PerftHash(hashMb));
+    }
+    std::printf("threads %d, hash %zu MB, %s attacks\n", threads, hashMb, pextEnabled ? "pext" : "magic");
+
+    if (!fen.empty())
+    {//하나의 국면만 측정
+        Board board;
+        if (!board.setFen(fen))
+        {
+            std::fprintf(stderr, "invalid fen: %s\n", fen.c_str());
+            return 2;
+        }
+        double seconds = 0;
+        uint64_t nodes = timedPerft(board, depth, threads, hash.get(), divide, seconds);
+        std::printf("depth %d  nodes %llu  time %.3fs  nps %.0f\n",
+                    depth, (unsigned long long)nodes, seconds, seconds > 0 ? nodes / seconds : 0.0);
+        return 0;
+    }
+
+    bool allPassed = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0;
+    for (const PerftPosition& position : suite)
+    {
+        Board board;
+        board.setFen(position.fen);
+        int testDepth = full ? position.fullDepth : position.depth;
+        uint64_t expected = full ? position.fullNodes : position.nodes;
+
+        if (divide)
+        {
+            std::printf("%s\n", position.name);
+        }
+        double seconds = 0;
+        uint64_t nodes = timedPerft(board, testDepth, threads, hash.get(), divide, seconds);
+        bool passed = nodes == expected;
+        allPassed = allPassed && passed;
+        totalNodes += nodes;
+        totalSeconds += seconds;
+
+        std::printf("%-10s depth %d  nodes %11llu  time %7.3fs  nps %11.0f  %s\n",
+                    position.name, testDepth, (unsigned long long)nodes, seconds,
+                    seconds > 0 ? nodes / seconds : 0.0, passed ? "ok" : "FAILED");
+        if (!passed)
+        {
+            std::printf("  expected %llu\n", (unsigned long long)expected);
+        }
+    }
+
+    int rejected = 0;
+    for (const char* fen : invalidFens)
+    {//규칙상 나올 수 없는 국면은 setFen이 거부해야 함
+        Board board;
+        if (board.setFen(fen))
+        {
+            std::printf("invalid fen accepted: %s\n", fen);
+        }
+        else
+        {
+            ++rejected;
+        }
+    }
+    int invalidCount = int(sizeof(invalidFens) / sizeof(invalidFens[0]));
+    std::printf("%-10s rejected %d/%d  %s\n", "badfen", rejected, invalidCount,
+                rejected == invalidCount ? "ok" : "FAILED");
+    allPassed = allPassed && rejected == invalidCount;
+
+    std::printf("total      nodes %llu  time %.3fs  nps %.0f\n",
+                (unsigned long long)totalNodes, totalSeconds, totalSeconds > 0 ? totalNodes / totalSeconds : 0.0);
+    return allPassed ? 0 : 1;
+}
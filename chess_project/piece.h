@@ -0,0 +1,61 @@
+#ifndef PIECE_H
+#define PIECE_H
+
+#include <cstdint>
+
+//기물의 색,종류와 두가지를 합친 기물 값
+//모두 1바이트 정수라 메일박스와 화면 객체에 그대로 저장하고 정수 비교로 판별한다
+
+enum Color : uint8_t
+{
+    White,
+    Black
+};
+
+enum PieceType : uint8_t
+{
+    Pawn,
+    Knight,
+    Bishop,
+    Rook,
+    Queen,
+    King,
+    NoPieceType
+};
+
+enum Piece : uint8_t
+{
+    WhitePawn,
+    WhiteKnight,
+    WhiteBishop,
+    WhiteRook,
+    WhiteQueen,
+    WhiteKing,
+    BlackPawn,
+    BlackKnight,
+    BlackBishop,
+    BlackRook,
+    BlackQueen,
+    BlackKing,
+    NoPiece
+};
+
+const int PieceValue[7] = { 100, 320, 330, 500, 900, 0, 0 };//PieceType 순서,킹과 NoPieceType은 0
+//수 정렬,교환 평가(SEE),델타 가지치기에서 함께 쓰는 단순 가치
+
+inline Piece makePiece(Color color, PieceType type)
+{
+    return Piece(color * 6 + type);
+}
+
+inline Color colorOf(Piece piece)
+{
+    return Color(piece / 6);//NoPiece에는 사용하지 않음
+}
+
+inline PieceType typeOf(Piece piece)
+{
+    return piece == NoPiece ? NoPieceType : PieceType(piece % 6);
+}
+
+#endif // PIECE_H
@@ -0,0 +1,754 @@
+#include "search.h"
+#include "evaluate.h"
+#include "movegen.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+static const int SkipSize[20] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+static const int SkipPhase[20] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+//보조 스레드가 건너뛸 깊이,스레드마다 다른 깊이를 탐색해 치환표를 서로 채워줌
+
+static_assert(MaxPly < NnueStackSize, "신경망 누산기 스택이 탐색 깊이보다 커야 함");
+static_assert(MaxPly <= MaxSearchPly, "보드의 되돌리기 스택이 탐색 깊이를 담을 수 있어야 함");
+
+static int lateMoveReduction[64][64];//[깊이][수 순서]에 대한 기본 축소량
+
+static void initReductions()
+{
+    for (int depth = 1; depth < 64; ++depth)
+    {
+        for (int moveCount = 1; moveCount < 64; ++moveCount)
+        {//깊고 늦게 나온 수일수록 많이 줄임
+            lateMoveReduction[depth][moveCount] = int(0.5 + std::log(depth) * std::log(moveCount) / 2.0);
+        }
+    }
+}
+
+static int scoreToTT(int score, int ply)
+//메이트 점수는 루트가 아니라 현재 노드 기준으로 저장
+{
+    if (score >= MateInMaxPly)
+    {
+        return score + ply;
+    }
+    if (score <= -MateInMaxPly)
+    {
+        return score - ply;
+    }
+    return score;
+}
+
+static int scoreFromTT(int score, int ply)
+{
+    if (score >= MateInMaxPly)
+    {
+        return score - ply;
+    }
+    if (score <= -MateInMaxPly)
+    {
+        return score + ply;
+    }
+    return score;
+}
+
+static int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+SearchWorker::SearchWorker(Search& owner, int index)
+    : owner(owner), id(index), nodes(0)
+{
+    std::memset(history, 0, sizeof(history));
+    for (auto& piece : counterMoves)
+    {
+        for (Move& move : piece)
+        {
+            move = Move();
+        }
+    }
+}
+
+void SearchWorker::prepare(const Board& position)
+{
+    board = position;
+    nnue.reset();
+    nodes.store(0, std::memory_order_relaxed);
+    pv[0][0] = Move();
+    pvLength[0] = 0;
+    std::memset(rootEffort, 0, sizeof(rootEffort));
+    bestMoveChanges = 0;
+    stableIterations = 0;
+    bestMove = Move();
+    ponderMove = Move();
+    bestScore = 0;
+    completedDepth = 0;
+    for (auto& pair : killers)
+    {
+        pair[0] = Move();
+        pair[1] = Move();
+    }
+    for (auto& side : history)
+    {//이전 탐색의 기록은 절반만 남김
+        for (auto& from : side)
+        {
+            for (int& value : from)
+            {
+                value /= 2;
+            }
+        }
+    }
+}
+
+void SearchWorker::iterate(int maxDepth)
+{
+    for (int depth = 1; depth <= maxDepth; ++depth)
+    {
+        if (id > 0)
+        {
+            int i = (id - 1) % 20;
+            if (((depth + SkipPhase[i]) / SkipSize[i]) % 2)
+            {
+                continue;
+            }
+        }
+
+        int score = aspirationSearch(depth, bestScore);
+        if (owner.stopped())
+        {
+            break;//중단된 반복의 결과는 버림
+        }
+
+        bool bestMoveChanged = completedDepth > 0 && pv[0][0] != bestMove;
+        int previousScore = bestScore;
+        bestMove = pv[0][0];
+        ponderMove = pvLength[0] > 1 ? pv[0][1] : Move();
+        bestScore = score;
+        completedDepth = depth;
+
+        if (id == 0)
+        {//시간 관리는 주 스레드만 함
+            double scale = timeScale(depth, score - previousScore, bestMoveChanged);
+            if (owner.singleReply || owner.softTimeUp(scale))
+            {
+                break;//다음 반복을 끝낼 시간이 부족하거나 더 볼 필요가 없음
+            }
+            if (score >= MateInMaxPly || score <= -MateInMaxPly)
+            {
+                break;//메이트를 찾았으면 더 깊이 볼 필요가 없음
+            }
+        }
+    }
+}
+
+double SearchWorker::timeScale(int depth, int scoreChange, bool bestMoveChanged)
+//최선 수가 자주 바뀌거나 점수가 떨어지면 시간을 늘리고,한 수에 노드가 몰려 있으면 줄임
+{
+    bestMoveChanges = bestMoveChanges / 2 + (bestMoveChanged ? 1 : 0);
+    stableIterations = bestMoveChanged ? 0 : stableIterations + 1;
+
+    double instability = 1.0 + bestMoveChanges;//최대 2배
+    double falling = 1.0 - scoreChange / 200.0;
+    falling = falling < 0.8 ? 0.8 : falling > 1.5 ? 1.5 : falling;
+
+    double effort = 1.0;
+    uint64_t total = nodeCount();
+    if (depth >= 8 && total > 0)
+    {
+        double share = double(rootEffort[bestMove.from()][bestMove.to()]) / double(total);
+        if (share > 0.9 && stableIterations >= 4)
+        {//다른 수는 모두 빠르게 반박되었으므로 확실한 최선 수
+            effort = 0.5;
+        }
+        else if (share > 0.75)
+        {
+            effort = 0.8;
+        }
+    }
+    return instability * falling * effort;
+}
+
+void SearchWorker::updateHistory(const Move& move, int bonus)
+{
+    int& entry = history[board.sideToMove()][move.from()][move.to()];
+    entry += bonus - entry * std::abs(bonus) / 16384;//값이 ±16384 안에 머물도록 감쇠
+}
+
+void SearchWorker::updateQuietStats(const Move& move, int ply, int depth, const Move* tried, int triedCount)
+//조용한 수로 컷오프가 났을때 킬러,카운터,히스토리 갱신,앞서 실패한 조용한 수는 감점
+{
+    if (killers[ply][0] != move)
+    {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+    if (ply > 0 && !currentMove[ply - 1].isNone())
+    {
+        int prevTo = currentMove[ply - 1].to();
+        counterMoves[board.pieceAt(prevTo)][prevTo] = move;
+    }
+
+    int bonus = depth * depth < 1600 ? depth * depth : 1600;
+    updateHistory(move, bonus);
+    for (int i = 0; i < triedCount; ++i)
+    {
+        updateHistory(tried[i], -bonus);
+    }
+}
+
+int SearchWorker::aspirationSearch(int depth, int previousScore)
+{
+    if (!owner.options.aspiration || depth < 5 || std::abs(previousScore) >= MateInMaxPly)
+    {
+        return search(-InfiniteScore, InfiniteScore, depth, 0);
+    }
+
+    int delta = 25;
+    int alpha = previousScore - delta;
+    int beta = previousScore + delta;
+    while (true)
+    {
+        int score = search(alpha, beta, depth, 0);
+        if (owner.stopped())
+        {
+            return 0;
+        }
+        if (score <= alpha)
+        {//창 밖으로 벗어난 쪽만 넓혀서 다시 탐색
+            alpha = score - delta > -InfiniteScore ? score - delta : -InfiniteScore;
+        }
+        else if (score >= beta)
+        {
+            beta = score + delta < InfiniteScore ? score + delta : InfiniteScore;
+        }
+        else
+        {
+            return score;
+        }
+        delta += delta;
+        if (delta > 1000)
+        {
+            alpha = -InfiniteScore;
+            beta = InfiniteScore;
+        }
+    }
+}
+
+int SearchWorker::staticEvaluate()
+{
+    return networkLoaded() ? nnue.evaluate(board) : evaluate(board, pawnTable);
+}
+
+bool SearchWorker::countNode()
+{
+    uint64_t count = nodes.load(std::memory_order_relaxed) + 1;
+    nodes.store(count, std::memory_order_relaxed);
+    if (id == 0 && completedDepth > 0 && (count & 1023) == 0 && owner.timeUp())
+    {//1024노드마다 시간 확인,1ms 이내에 멈출 수 있음,깊이 1은 시간이 지나도 끝까지 탐색
+        owner.stop();
+    }
+    return owner.stopped();
+}
+
+int SearchWorker::qsearch(int alpha, int beta, int ply)
+{
+    const int DeltaMargin = 200;//잡은 기물 가치에 더해주는 여유,위치 점수 변화를 감안
+
+    bool pvNode = beta - alpha > 1;
+    int originalAlpha = alpha;
+    pvLength[ply] = ply;
+    if (countNode())
+    {
+        return 0;
+    }
+    if (ply > 0 && board.repetitions() > 0)
+    {
+        return 0;
+    }
+    bool inCheck = board.inCheck();
+    if (ply >= MaxPly - 1)
+    {
+        return inCheck ? 0 : staticEvaluate();
+    }
+
+    TranspositionTable& tt = owner.tt;
+    TTData ttData;
+    bool ttHit = tt.probe(board.key(), ttData);
+    if (ttHit && !pvNode)
+    {//정지 탐색 결과는 깊이 0,어떤 깊이의 결과도 사용 가능
+        int ttScore = scoreFromTT(ttData.score, ply);
+        if (ttData.bound == BoundExact
+            || (ttData.bound == BoundLower && ttScore >= beta)
+            || (ttData.bound == BoundUpper && ttScore <= alpha))
+        {
+            return ttScore;
+        }
+    }
+
+    int staticEval = 0;
+    int bestScore = -InfiniteScore;
+    if (!inCheck)
+    {//체크가 아니면 잡지 않고 멈추는 선택도 가능
+        staticEval = ttHit ? ttData.eval : staticEvaluate();
+        bestScore = staticEval;
+        if (bestScore >= beta)
+        {
+            if (!ttHit)
+            {
+                tt.store(board.key(), 0, BoundLower, scoreToTT(bestScore, ply), staticEval, Move());
+            }
+            return bestScore;
+        }
+        if (bestScore > alpha)
+        {
+            alpha = bestScore;
+        }
+    }
+
+    static const Move noKillers[2];
+    Move ttMove = ttHit ? ttData.move : Move();
+    MovePicker picker = inCheck ? MovePicker(board, ttMove, noKillers, Move(), history)
+                                : MovePicker(board, ttMove, history);
+    //체크중에는 모든 회피수를 봄
+    Move bestMove;
+    int moveCount = 0;
+    for (Move move = picker.next(); !move.isNone(); move = picker.next())
+    {
+        ++moveCount;
+        if (!inCheck)
+        {
+            if (move.moveFlag() == PromotionMove && move.promotionType() != Queen)
+            {
+                continue;//정지 탐색에서는 퀸 프로모션만
+            }
+            PieceType victim = move.moveFlag() == EnPassantMove ? Pawn : typeOf(board.pieceAt(move.to()));
+            if (move.moveFlag() != PromotionMove && staticEval + PieceValue[victim] + DeltaMargin <= alpha)
+            {//잡아도 alpha에 닿지 못하는 수는 델타 가지치기
+                continue;
+            }
+            if (!board.seeGe(move, 0))
+            {//교환에서 손해를 보는 잡기는 보지 않음
+                continue;
+            }
+        }
+
+        currentMove[ply] = move;
+        makeMove(move);
+        tt.prefetch(board.key());
+        int score = -qsearch(-beta, -alpha, ply + 1);
+        unmakeMove(move);
+
+        if (owner.stopped())
+        {
+            return 0;
+        }
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                bestMove = move;
+                alpha = score;
+                if (alpha >= beta)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (inCheck && moveCount == 0)
+    {
+        return -MateScore + ply;
+    }
+
+    Bound bound = bestScore >= beta ? BoundLower : bestScore > originalAlpha ? BoundExact : BoundUpper;
+    tt.store(board.key(), 0, bound, scoreToTT(bestScore, ply), staticEval, bestMove);
+    return bestScore;
+}
+
+int SearchWorker::search(int alpha, int beta, int depth, int ply)
+{
+    bool pvNode = beta - alpha > 1;
+    int originalAlpha = alpha;
+    pvLength[ply] = ply;
+
+    if (countNode())
+    {
+        return 0;
+    }
+
+    if (ply > 0 && board.repetitions() > 0)
+    {//탐색 중에는 한번만 반복되어도 무승부로 봄
+        return 0;
+    }
+
+    bool inCheck = board.inCheck();
+    if (inCheck)
+    {
+        ++depth;//체크 연장
+    }
+    if (depth <= 0)
+    {
+        return qsearch(alpha, beta, ply);
+    }
+    if (ply >= MaxPly - 1)
+    {
+        return staticEvaluate();
+    }
+
+    TranspositionTable& tt = owner.tt;
+    TTData ttData;
+    bool ttHit = tt.probe(board.key(), ttData);
+    Move ttMove = ttHit ? ttData.move : Move();
+    if (ttHit && !pvNode && ttData.depth >= depth)
+    {//충분히 깊게 본 결과가 창 밖이면 바로 사용
+        int ttScore = scoreFromTT(ttData.score, ply);
+        if (ttData.bound == BoundExact
+            || (ttData.bound == BoundLower && ttScore >= beta)
+            || (ttData.bound == BoundUpper && ttScore <= alpha))
+        {
+            return ttScore;
+        }
+    }
+    int staticEval = ttHit ? ttData.eval : staticEvaluate();
+
+    if (board.isFiftyMoveDraw())
+    {//50수째에 체크메이트라면 메이트가 우선
+        MoveList evasions;
+        if (inCheck)
+        {
+            generateLegalMoves(board, evasions);
+        }
+        return inCheck && evasions.empty() ? -MateScore + ply : 0;
+    }
+
+    const SearchOptions& options = owner.options;
+    if (!pvNode && !inCheck)
+    {
+        if (options.reverseFutility && depth <= 6 && std::abs(beta) < MateInMaxPly
+            && staticEval - 80 * depth >= beta)
+        {//정적 평가가 여유있게 beta를 넘으면 얕은 깊이에서는 그대로 컷오프
+            return staticEval;
+        }
+
+        if (options.nullMove && depth >= 3 && ply > 0 && !currentMove[ply - 1].isNone()
+            && staticEval >= beta && board.hasNonPawnMaterial(board.sideToMove()))
+        {//차례를 넘겨도 beta를 넘으면 컷오프,연속 널 무브와 폰만 남은 추크츠방 국면은 제외
+            int reduction = 3 + depth / 4;
+            currentMove[ply] = Move();
+            nnue.pushNull();
+            board.makeNullMove();
+            tt.prefetch(board.key());
+            int score = -search(-beta, -beta + 1, depth - 1 - reduction, ply + 1);
+            board.unmakeNullMove();
+            nnue.pop();
+            if (owner.stopped())
+            {
+                return 0;
+            }
+            if (score >= beta)
+            {
+                return score >= MateInMaxPly ? beta : score;//확인되지 않은 메이트 점수는 돌려주지 않음
+            }
+        }
+    }
+
+    if (ply == 0 && !pv[0][0].isNone())
+    {
+        ttMove = pv[0][0];//루트는 이전 반복의 최선수를 먼저 탐색
+    }
+    Move counterMove;
+    if (ply > 0 && !currentMove[ply - 1].isNone())
+    {
+        int prevTo = currentMove[ply - 1].to();
+        counterMove = counterMoves[board.pieceAt(prevTo)][prevTo];
+    }
+    MovePicker picker(board, ttMove, killers[ply], counterMove, history);
+
+    int bestScore = -InfiniteScore;
+    Move bestMove;
+    Move quietsTried[64];//컷오프가 나면 감점할 조용한 수
+    int quietCount = 0;
+    int moveCount = 0;
+    for (Move move = picker.next(); !move.isNone(); move = picker.next())
+    {
+        bool quiet = board.isEmpty(move.to()) && move.moveFlag() != EnPassantMove
+                     && move.moveFlag() != PromotionMove;
+        ++moveCount;
+
+        if (options.futility && !pvNode && !inCheck && quiet && moveCount > 1 && depth <= 6
+            && bestScore > -MateInMaxPly && staticEval + 100 + 100 * depth <= alpha)
+        {//얕은 깊이에서 조용한 수로는 alpha에 닿을 가망이 없음
+            continue;
+        }
+
+        currentMove[ply] = move;
+        uint64_t nodesBefore = nodeCount();
+        makeMove(move);
+        tt.prefetch(board.key());
+        int newDepth = depth - 1;
+        int score;
+        if (moveCount == 1)
+        {
+            score = -search(-beta, -alpha, newDepth, ply + 1);
+        }
+        else
+        {
+            int reduction = 0;
+            if (options.lateMoveReductions && depth >= 3 && quiet && !inCheck && moveCount > (pvNode ? 3 : 1))
+            {//늦게 나온 조용한 수는 얕게 먼저 확인
+                reduction = lateMoveReduction[depth < 63 ? depth : 63][moveCount < 63 ? moveCount : 63];
+                if (pvNode)
+                {
+                    --reduction;
+                }
+                if (reduction > newDepth - 1)
+                {
+                    reduction = newDepth - 1;
+                }
+                if (reduction < 0)
+                {
+                    reduction = 0;
+                }
+            }
+
+            //나머지 수는 좁은 창으로 확인하고 alpha를 넘을 때만 다시 탐색
+            score = -search(-alpha - 1, -alpha, newDepth - reduction, ply + 1);
+            if (reduction > 0 && score > alpha)
+            {
+                score = -search(-alpha - 1, -alpha, newDepth, ply + 1);
+            }
+            if (score > alpha && score < beta)
+            {
+                score = -search(-beta, -alpha, newDepth, ply + 1);
+            }
+        }
+        unmakeMove(move);
+        if (ply == 0)
+        {
+            rootEffort[move.from()][move.to()] += nodeCount() - nodesBefore;
+        }
+
+        if (owner.stopped())
+        {
+            return 0;
+        }
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha)
+            {
+                alpha = score;
+                pv[ply][ply] = move;//최선 수순 갱신
+                for (int next = ply + 1; next < pvLength[ply + 1]; ++next)
+                {
+                    pv[ply][next] = pv[ply + 1][next];
+                }
+                pvLength[ply] = pvLength[ply + 1];
+                if (alpha >= beta)
+                {
+                    if (quiet)
+                    {
+                        updateQuietStats(move, ply, depth, quietsTried, quietCount);
+                    }
+                    break;
+                }
+            }
+        }
+        if (quiet && quietCount < 64)
+        {
+            quietsTried[quietCount++] = move;
+        }
+    }
+
+    if (moveCount == 0)
+    {
+        return inCheck ? -MateScore + ply : 0;//빨리 당하는 메이트일수록 낮은 점수
+    }
+
+    Bound bound = bestScore >= beta ? BoundLower : bestScore > originalAlpha ? BoundExact : BoundUpper;
+    tt.store(board.key(), depth, bound, scoreToTT(bestScore, ply), staticEval,
+             bound == BoundUpper ? Move() : bestMove);
+    return bestScore;
+}
+
+Search::Search()
+    : stopRequested(false), running(false), pondering(false), timeBase(0), deadline(0)
+{
+    initReductions();
+    setThreads(1);
+}
+
+Search::~Search()
+{
+    stop();
+    wait();
+}
+
+void Search::start(const Board& position, const SearchLimits& limits, Callback onFinished)
+{
+    stop();
+    wait();//이전 탐색이 남아있으면 정리
+
+    stopRequested.store(false, std::memory_order_relaxed);
+    running.store(true, std::memory_order_release);
+    mainThread = std::thread([this, position, limits, onFinished]()
+    {
+        SearchResult result = think(position, limits);
+        running.store(false, std::memory_order_release);
+        if (onFinished)
+        {
+            onFinished(result);
+        }
+    });
+}
+
+void Search::stop()
+{
+    pondering.store(false, std::memory_order_relaxed);
+    stopRequested.store(true, std::memory_order_relaxed);
+}
+
+void Search::ponderHit()
+{
+    int64_t now = nowNs();
+    timeBase.store(now, std::memory_order_relaxed);
+    deadline.store(now + int64_t(timeManager.maximumMs()) * 1000000, std::memory_order_relaxed);
+    pondering.store(false, std::memory_order_release);
+}
+
+void Search::wait()
+{
+    if (mainThread.joinable())
+    {
+        mainThread.join();
+    }
+}
+
+SearchResult Search::run(const Board& position, const SearchLimits& limits)
+{
+    stop();
+    wait();
+
+    stopRequested.store(false, std::memory_order_relaxed);
+    return think(position, limits);
+}
+
+void Search::setThreads(int count)
+{
+    stop();
+    wait();
+    if (count < 1)
+    {
+        count = 1;
+    }
+    workers.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        workers.emplace_back(new SearchWorker(*this, i));
+    }
+}
+
+bool Search::setHashSize(size_t megabytes)
+{
+    stop();
+    wait();
+    return tt.resize(megabytes);
+}
+
+void Search::clearHash()
+{
+    stop();
+    wait();
+    tt.clear();
+}
+
+int Search::elapsedMs() const
+{
+    return int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - startTime).count());
+}
+
+bool Search::timeUp() const
+{
+    return timeManager.enabled() && !pondering.load(std::memory_order_relaxed)
+           && nowNs() >= deadline.load(std::memory_order_relaxed);
+}
+
+bool Search::softTimeUp(double scale) const
+{
+    return timeManager.enabled() && !pondering.load(std::memory_order_relaxed)
+           && nowNs() - timeBase.load(std::memory_order_relaxed) >= int64_t(timeManager.softLimitMs(scale)) * 1000000;
+}
+
+SearchResult Search::think(const Board& position, const SearchLimits& limits)
+{
+    startTime = std::chrono::steady_clock::now();
+    timeManager.init(limits.timeLeftMs, limits.incrementMs, limits.movesToGo, limits.moveTimeMs,
+                     position.fullmoveNumber());
+    int64_t now = nowNs();
+    timeBase.store(now, std::memory_order_relaxed);
+    deadline.store(now + int64_t(timeManager.maximumMs()) * 1000000, std::memory_order_relaxed);
+    pondering.store(limits.ponder, std::memory_order_relaxed);
+    tt.newSearch();
+
+    SearchResult result;
+    MoveList rootMoves;
+    generateLegalMoves(position, rootMoves);
+    if (rootMoves.empty())
+    {
+        return result;
+    }
+    singleReply = rootMoves.size() == 1 && timeManager.enabled();
+
+    int maxDepth = limits.maxDepth < MaxPly - 1 ? limits.maxDepth : MaxPly - 1;
+    for (auto& searchWorker : workers)
+    {
+        searchWorker->prepare(position);
+    }
+
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < workers.size(); ++i)
+    {//보조 스레드는 주 스레드가 멈추라고 할때까지 탐색
+        SearchWorker* helper = workers[i].get();
+        helpers.emplace_back([helper]()
+        {
+            helper->iterate(MaxPly - 1);
+        });
+    }
+    workers[0]->iterate(maxDepth);
+
+    while (pondering.load(std::memory_order_acquire) && !stopped())
+    {//예상 수 탐색중에는 끝까지 보았더라도 ponderHit이나 stop을 기다림
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop();
+    for (std::thread& helper : helpers)
+    {
+        helper.join();
+    }
+
+    const SearchWorker* best = workers[0].get();
+    for (auto& searchWorker : workers)
+    {//더 깊이 끝낸 보조 스레드가 더 좋은 점수를 찾았다면 그 결과를 사용
+        if (searchWorker->completedDepth > best->completedDepth && searchWorker->bestScore > best->bestScore)
+        {
+            best = searchWorker.get();
+        }
+        result.threadNodes.push_back(searchWorker->nodeCount());
+        result.nodes += searchWorker->nodeCount();
+    }
+    result.bestMove = best->completedDepth > 0 ? best->bestMove : rootMoves[0];
+    //첫 반복이 끝나기 전에 멈췄다면 아무 합법수
+    result.ponderMove = best->completedDepth > 0 ? best->ponderMove : Move();
+    result.score = best->bestScore;
+    result.depth = best->completedDepth;
+    result.timeMs = elapsedMs();
+    result.hashfull = tt.hashfull();
+    return result;
+}
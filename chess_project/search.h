@@ -0,0 +1,187 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "board.h"
+#include "tt.h"
+#include "movepick.h"
+#include "nnue.h"
+#include "evaluate.h"
+#include "timeman.h"
+
+//반복 심화와 주변이 탐색(PVS)을 사용하는 알파베타 탐색
+//GUI와 독립적으로 작업 스레드에서 실행되며 결과는 콜백으로 전달
+//여러 스레드가 같은 루트를 서로 다른 깊이로 탐색하고 치환표로 결과를 나누는 Lazy SMP
+
+const int MaxPly = 128;//탐색 트리의 최대 깊이
+const int MateScore = 32000;
+const int MateInMaxPly = MateScore - MaxPly;//이보다 큰 점수는 메이트 점수
+const int InfiniteScore = 32001;
+
+struct SearchLimits
+{
+    int maxDepth = MaxPly - 1;
+    int moveTimeMs = 0;//고정 시간,0이면 아래 시계 정보로 시간을 정함
+    int timeLeftMs = 0;//두는 쪽 시계의 남은 시간,moveTimeMs와 함께 0이면 stop을 부를때까지 탐색
+    int incrementMs = 0;//한 수를 둘때마다 더해지는 시간
+    int movesToGo = 0;//다음 시간 추가까지 남은 수,0이면 남은 시간으로 게임 끝까지
+    bool ponder = false;//ponderHit을 부르기 전까지는 시간 제한을 적용하지 않음
+};
+
+struct SearchOptions
+//가지치기와 축소 기법 스위치,벤치마크로 각 기법의 효과를 측정할때 끔
+{
+    bool nullMove = true;
+    bool lateMoveReductions = true;
+    bool reverseFutility = true;
+    bool futility = true;
+    bool aspiration = true;
+};
+
+struct SearchResult
+{
+    Move bestMove;//합법수가 없으면 isNone
+    Move ponderMove;//상대의 예상 응수,없으면 isNone
+    int score = 0;
+    int depth = 0;//끝까지 탐색한 깊이
+    uint64_t nodes = 0;//모든 스레드의 합
+    int timeMs = 0;
+    int hashfull = 0;//치환표 중 이번 탐색에서 기록된 항목의 천분율
+    std::vector<uint64_t> threadNodes;//스레드별 노드 수,0번이 주 스레드
+
+    uint64_t nps() const
+    {
+        return timeMs > 0 ? nodes * 1000 / uint64_t(timeMs) : nodes;
+    }
+};
+
+class Search;
+
+class SearchWorker
+//탐색 스레드 하나의 상태,보드와 수순과 히스토리는 스레드마다 따로 가짐
+{
+public:
+    SearchWorker(Search& owner, int index);
+
+    void prepare(const Board& position);//새 탐색 전에 루트 국면과 통계를 초기화
+    void iterate(int maxDepth);//반복 심화,주 스레드는 시간을 관리하고 나머지는 멈출때까지 탐색
+
+    uint64_t nodeCount() const
+    {
+        return nodes.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class Search;
+
+    int search(int alpha, int beta, int depth, int ply);
+    int aspirationSearch(int depth, int previousScore);//직전 점수 주변의 좁은 창으로 루트 탐색
+    int qsearch(int alpha, int beta, int ply);//잡는 수만 보는 정지 탐색
+    bool countNode();//노드 수를 세고 시간을 확인,멈춰야 하면 true
+    void makeMove(const Move& move)//보드와 신경망 누산기를 함께 갱신
+    {
+        nnue.push(board, move);
+        board.makeMove(move);
+    }
+    void unmakeMove(const Move& move)
+    {
+        board.unmakeMove(move);
+        nnue.pop();
+    }
+    int staticEvaluate();//신경망을 읽었으면 신경망,아니면 기존 평가
+    void updateHistory(const Move& move, int bonus);
+    void updateQuietStats(const Move& move, int ply, int depth, const Move* tried, int triedCount);
+    double timeScale(int depth, int score, bool bestMoveChanged);//이번 반복 결과로 정한 optimum 배율
+
+    Search& owner;
+    int id;
+    Board board;//탐색중 수를 두고 되돌리는 보드
+    NnueState nnue;
+    PawnTable pawnTable;//폰 구조 평가 캐시
+    std::atomic<uint64_t> nodes;//다른 스레드가 통계를 읽을 수 있도록 atomic
+
+    Move pv[MaxPly][MaxPly];//각 깊이에서 찾은 최선 수순
+    int pvLength[MaxPly];
+    ButterflyHistory history;//조용한 수의 컷오프 기록,스레드마다 따로 유지
+    Move killers[MaxPly][2];//같은 깊이에서 컷오프를 낸 조용한 수
+    Move counterMoves[12][64];//[상대가 움직인 기물][도착칸]에 대한 반격 수
+    Move currentMove[MaxPly];//각 깊이에서 탐색중인 수
+    uint64_t rootEffort[64][64];//루트 수별로 사용한 노드 수,[출발칸][도착칸]
+    double bestMoveChanges = 0;//최선 수가 바뀐 횟수,반복마다 절반으로 줄임
+    int stableIterations = 0;//최선 수가 바뀌지 않고 이어진 반복 수
+
+    Move bestMove;
+    Move ponderMove;
+    int bestScore = 0;
+    int completedDepth = 0;
+};
+
+class Search
+{
+public:
+    using Callback = std::function<void(const SearchResult&)>;
+
+    Search();
+    ~Search();
+
+    void start(const Board& position, const SearchLimits& limits, Callback onFinished);
+    //작업 스레드에서 탐색을 시작,끝나면 작업 스레드에서 onFinished를 호출
+    void stop();//탐색 중단 요청,1ms 안에 가장 최근 결과로 끝남
+    void ponderHit();//예상한 수를 상대가 두었으므로 지금부터 시간 제한 적용
+    void wait();//작업 스레드가 끝날때까지 대기
+    bool searching() const
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    SearchResult run(const Board& position, const SearchLimits& limits);//현재 스레드에서 탐색
+
+    void setThreads(int count);//탐색중이 아닐때만 호출
+    int threads() const
+    {
+        return int(workers.size());
+    }
+    bool setHashSize(size_t megabytes);//탐색중이 아닐때만 호출,메모리가 부족해 더 작게 할당되면 false
+    void clearHash();//새 게임을 시작할때
+    void setOptions(const SearchOptions& searchOptions)//탐색중이 아닐때만 호출
+    {
+        options = searchOptions;
+    }
+    const SearchOptions& currentOptions() const
+    {
+        return options;
+    }
+
+private:
+    friend class SearchWorker;
+
+    SearchResult think(const Board& position, const SearchLimits& limits);
+    bool stopped() const
+    {
+        return stopRequested.load(std::memory_order_relaxed);
+    }
+    bool timeUp() const;
+    bool softTimeUp(double scale) const;//optimum에 scale을 곱한 시간이 지났으면 다음 반복을 시작하지 않음
+    int elapsedMs() const;
+
+    TranspositionTable tt;
+    SearchOptions options;
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+    std::thread mainThread;//주 탐색 스레드,보조 스레드는 이 스레드가 만들고 정리
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> running;
+    std::atomic<bool> pondering;
+
+    std::chrono::steady_clock::time_point startTime;
+    TimeManager timeManager;
+    std::atomic<int64_t> timeBase;//시간 계산의 시작점,steady_clock 기준 나노초,ponderHit에서 다시 설정
+    std::atomic<int64_t> deadline;//넘으면 즉시 멈추는 시각,timeBase + maximum
+    bool singleReply = false;//합법수가 하나뿐이면 첫 반복 후 바로 둠
+};
+
+#endif // SEARCH_H
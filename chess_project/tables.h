@@ -0,0 +1,154 @@
+#ifndef TABLES_H
+#define TABLES_H
+
+#include <array>
+#include "bitboard.h"
+#include "piece.h"
+
+//컴파일 시간에 만들어지는 비트보드 표
+//나이트,킹,폰 공격과 방향별 광선,두 칸 사이,두 칸을 지나는 직선
+//실행시 초기화가 필요없어 어느 시점에서 사용해도 안전하다
+
+enum Direction
+{
+    North,
+    South,
+    East,
+    West,
+    NorthEast,
+    SouthWest,
+    NorthWest,
+    SouthEast
+};
+//반대 방향끼리 짝을 이루도록 배치,d ^ 1이 반대 방향
+
+constexpr int directionFile[8] = { 0, 0, 1, -1, 1, -1, -1, 1 };
+constexpr int directionRank[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+
+constexpr Bitboard offsetBit(int square, int fileStep, int rankStep)
+//판을 벗어나면 0을 반환
+{
+    int file = fileOf(square) + fileStep;
+    int rank = rankOf(square) + rankStep;
+    return (file >= 0 && file < 8 && rank >= 0 && rank < 8) ? squareBit(makeSquare(file, rank)) : 0;
+}
+
+constexpr std::array<Bitboard, 64> makeKnightAttacks()
+{
+    constexpr int steps[8][2] = { { 1, 2 }, { 2, 1 }, { 2, -1 }, { 1, -2 },
+                                  { -1, -2 }, { -2, -1 }, { -2, 1 }, { -1, 2 } };
+    std::array<Bitboard, 64> table = {};
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            table[sq] |= offsetBit(sq, steps[i][0], steps[i][1]);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<Bitboard, 64> makeKingAttacks()
+{
+    std::array<Bitboard, 64> table = {};
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        for (int d = 0; d < 8; ++d)
+        {
+            table[sq] |= offsetBit(sq, directionFile[d], directionRank[d]);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<Bitboard, 64>, 2> makePawnAttacks()
+{
+    std::array<std::array<Bitboard, 64>, 2> table = {};
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        table[0][sq] = offsetBit(sq, -1, 1) | offsetBit(sq, 1, 1);//백은 위쪽 대각선
+        table[1][sq] = offsetBit(sq, -1, -1) | offsetBit(sq, 1, -1);//흑은 아래쪽 대각선
+    }
+    return table;
+}
+
+constexpr std::array<std::array<Bitboard, 64>, 8> makeRays()
+{
+    std::array<std::array<Bitboard, 64>, 8> table = {};
+    for (int d = 0; d < 8; ++d)
+    {
+        for (int sq = 0; sq < 64; ++sq)
+        {
+            for (int step = 1; step < 8; ++step)
+            {
+                table[d][sq] |= offsetBit(sq, directionFile[d] * step, directionRank[d] * step);
+            }
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<Bitboard, 64>, 64> makeBetween()
+{
+    std::array<std::array<Bitboard, 64>, 64> table = {};
+    for (int from = 0; from < 64; ++from)
+    {
+        for (int d = 0; d < 8; ++d)
+        {
+            Bitboard passed = 0;//지금까지 지나온 칸
+            for (int step = 1; step < 8; ++step)
+            {
+                Bitboard bit = offsetBit(from, directionFile[d] * step, directionRank[d] * step);
+                if (!bit)
+                {
+                    break;
+                }
+                table[from][lsb(bit)] = passed;
+                passed |= bit;
+            }
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<Bitboard, 64>, 64> makeLines()
+{
+    constexpr std::array<std::array<Bitboard, 64>, 8> rays = makeRays();
+    std::array<std::array<Bitboard, 64>, 64> table = {};
+    for (int from = 0; from < 64; ++from)
+    {
+        for (int d = 0; d < 8; ++d)
+        {
+            Bitboard line = rays[d][from] | rays[d ^ 1][from] | squareBit(from);
+            //양쪽 광선과 자기 칸을 합친 직선
+            for (Bitboard b = rays[d][from]; b; b &= b - 1)
+            {
+                table[from][lsb(b)] = line;
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<Bitboard, 64> KnightAttacks = makeKnightAttacks();
+inline constexpr std::array<Bitboard, 64> KingAttacks = makeKingAttacks();
+inline constexpr std::array<std::array<Bitboard, 64>, 2> PawnAttacks = makePawnAttacks();//[색][칸]
+inline constexpr std::array<std::array<Bitboard, 64>, 8> Rays = makeRays();//[방향][칸],칸 자신은 제외
+inline constexpr std::array<std::array<Bitboard, 64>, 64> BetweenBB = makeBetween();//두 칸 사이,양 끝 제외
+inline constexpr std::array<std::array<Bitboard, 64>, 64> LineBB = makeLines();//두 칸을 지나는 직선 전체
+
+inline Bitboard pawnAttacksOf(Color color, Bitboard pawns)//여러 폰의 공격 칸을 한번에 계산
+{
+    if (color == White)
+    {
+        return ((pawns & ~FileABB) << 7) | ((pawns & ~FileHBB) << 9);
+    }
+    return ((pawns & ~FileABB) >> 9) | ((pawns & ~FileHBB) >> 7);
+}
+
+inline bool aligned(int a, int b, int c)//세 칸이 한 직선 위에 있는지
+{
+    return (LineBB[a][b] & squareBit(c)) != 0;
+}
+
+#endif // TABLES_H
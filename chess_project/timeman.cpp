@@ -0,0 +1,69 @@
+#include "timeman.h"
+
+void TimeManager::init(int timeLeftMs, int incrementMs, int movesToGo, int moveTimeMs, int moveNumber)
+{
+    if (moveTimeMs > 0)
+    {//고정 시간,다음 반복을 끝내지 못할 가능성이 높은 절반 이후로는 새 반복을 시작하지 않음
+        maximum = moveTimeMs;
+        optimum = moveTimeMs / 2;
+        return;
+    }
+    if (timeLeftMs <= 0)
+    {
+        optimum = 0;
+        maximum = 0;
+        return;
+    }
+
+    int movesLeft = movesToGo;
+    if (movesLeft <= 0)
+    {//남은 수를 모르면 게임 초반일수록 길게 잡음
+        movesLeft = 50 - moveNumber / 2;
+        if (movesLeft < 25)
+        {
+            movesLeft = 25;
+        }
+    }
+    if (movesLeft > 50)
+    {
+        movesLeft = 50;
+    }
+
+    int overhead = MoveOverheadMs < timeLeftMs / 2 ? MoveOverheadMs : timeLeftMs / 2;
+    int reserve = overhead * (movesLeft + 2);
+    if (reserve > timeLeftMs * 3 / 4)
+    {//시간이 얼마 안 남으면 여유분이 남은 시간을 다 차지하지 않도록 3/4까지만 뺌
+        reserve = timeLeftMs * 3 / 4;
+    }
+    int available = timeLeftMs + incrementMs * (movesLeft - 1) - reserve;
+    //남은 수마다 여유분을 미리 빼두고 앞으로 받을 증가 시간은 더함,그래야 끝까지 시간이 남음
+    optimum = available / movesLeft;
+    maximum = movesLeft == 1 ? available : optimum * 5;
+
+    int usable = timeLeftMs - overhead;//시계에 실제로 남은 시간 중 이번 수에 쓸 수 있는 한도
+    int ceiling = movesLeft == 1 ? usable * 4 / 5 : usable / 4;
+    //남은 수가 여러개면 한 수에 남은 시간의 1/4 이상 쓰지 않음
+    if (maximum > ceiling)
+    {
+        maximum = ceiling;
+    }
+
+    int minimum = MinMoveMs < timeLeftMs / 100 ? MinMoveMs : timeLeftMs / 100;
+    //시간이 거의 없어도 얕은 탐색을 할 시간은 남김,남은 시간이 1초 아래면 그에 비례해 줄임
+    if (maximum < minimum)
+    {
+        maximum = minimum;
+    }
+    if (maximum < 1)
+    {
+        maximum = 1;
+    }
+    if (optimum < minimum)
+    {
+        optimum = minimum;
+    }
+    if (optimum > maximum)
+    {
+        optimum = maximum;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef TIMEMAN_H
+#define TIMEMAN_H
+
+//남은 시간,증가 시간,남은 수로 이번 수에 쓸 시간을 정하는 시간 관리
+//optimum은 보통 쓰려는 시간이고 탐색은 최선 수가 흔들리면 늘이고 확실하면 줄여서 사용
+//maximum은 어떤 경우에도 넘지 않는 시간으로 시계가 다 떨어지지 않도록 여유를 남김
+
+const int MoveOverheadMs = 50;//GUI가 수를 받아 시계를 멈출때까지 걸리는 시간의 여유분
+const int MinMoveMs = 10;//남은 시간이 적어도 한 수에 쓰는 최소 시간
+
+class TimeManager
+{
+public:
+    void init(int timeLeftMs, int incrementMs, int movesToGo, int moveTimeMs, int moveNumber);
+    //moveTimeMs가 있으면 그 시간을 그대로 쓰고,없으면 남은 시간으로 계산,모두 0이면 시간 제한 없음
+    bool enabled() const
+    {
+        return maximum > 0;
+    }
+    int optimumMs() const
+    {
+        return optimum;
+    }
+    int maximumMs() const
+    {
+        return maximum;
+    }
+    int softLimitMs(double scale) const//optimum에 배율을 적용한 시간,maximum을 넘지 않음
+    {
+        int limit = int(optimum * scale);
+        return limit < maximum ? limit : maximum;
+    }
+
+private:
+    int optimum = 0;
+    int maximum = 0;
+};
+
+#endif // TIMEMAN_H
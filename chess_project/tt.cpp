@@ -0,0 +1,190 @@
+#include "tt.h"
+#include <cstdlib>
+#include <cstring>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+static void* allocateLarge(size_t bytes)
+//큰 페이지를 사용할 수 있도록 2MB 단위로 정렬해서 할당
+{
+    const size_t alignment = 2 * 1024 * 1024;
+    size_t size = (bytes + alignment - 1) / alignment * alignment;
+    void* memory = nullptr;
+#if defined(_WIN32)
+    memory = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&memory, alignment, size) != 0)
+    {
+        memory = nullptr;
+    }
+#endif
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (memory)
+    {
+        madvise(memory, size, MADV_HUGEPAGE);//실패해도 일반 페이지로 동작
+    }
+#endif
+    return memory;
+}
+
+static void freeLarge(void* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+TranspositionTable::TranspositionTable()
+{
+    resize(16);
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    release();
+}
+
+void TranspositionTable::release()
+{
+    if (buckets && buckets != &fallback)
+    {
+        freeLarge(buckets);
+    }
+    buckets = nullptr;
+    bucketCount = 0;
+    mask = 0;
+    allocatedBytes = 0;
+}
+
+bool TranspositionTable::resize(size_t megabytes)
+{
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+    {//인덱스를 마스크로 구할 수 있도록 2의 거듭제곱 개수
+        count *= 2;
+    }
+    if (count * sizeof(Bucket) == allocatedBytes)
+    {
+        clear();
+        return true;
+    }
+
+    release();
+    buckets = static_cast<Bucket*>(allocateLarge(count * sizeof(Bucket)));
+    bool allocated = buckets != nullptr;
+    if (!buckets)
+    {//메모리가 부족하면 최소 크기로,그것도 안되면 객체 안의 버킷 하나를 사용
+        count = 1;
+        buckets = static_cast<Bucket*>(allocateLarge(sizeof(Bucket)));
+        if (!buckets)
+        {
+            buckets = &fallback;
+        }
+    }
+    bucketCount = count;
+    mask = count - 1;
+    allocatedBytes = count * sizeof(Bucket);
+    clear();
+    return allocated;
+}
+
+void TranspositionTable::clear()
+{
+    std::memset(static_cast<void*>(buckets), 0, allocatedBytes);
+    //atomic<uint64_t>는 잠금이 없는 일반 정수라 0으로 채워도 됨
+    generation = 0;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTData& data) const
+{
+    const Bucket* bucket = bucketFor(key);
+    for (const Entry& entry : bucket->entries)
+    {
+        uint64_t value = entry.data.load(std::memory_order_relaxed);
+        if ((entry.check.load(std::memory_order_relaxed) ^ value) != key)
+        {
+            continue;
+        }
+        Bound bound = Bound((value >> 56) & 3);
+        if (bound == BoundNone)
+        {
+            return false;
+        }
+        data.move = Move::fromRaw(uint16_t(value));
+        data.score = int16_t(value >> 16);
+        data.eval = int16_t(value >> 32);
+        data.depth = int8_t(value >> 48);
+        data.bound = bound;
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, Bound bound, int score, int eval, Move move)
+{
+    Bucket* bucket = bucketFor(key);
+    Entry* replace = &bucket->entries[0];
+    int replaceValue = 1 << 30;
+    for (Entry& entry : bucket->entries)
+    {
+        uint64_t value = entry.data.load(std::memory_order_relaxed);
+        if ((entry.check.load(std::memory_order_relaxed) ^ value) == key)
+        {//같은 국면은 항상 덮어쓰고,새 수가 없으면 이전 수를 유지
+            if (move.isNone())
+            {
+                move = Move::fromRaw(uint16_t(value));
+            }
+            replace = &entry;
+            break;
+        }
+        int entryAge = (generation - int(value >> 58)) & 63;
+        int entryValue = int(int8_t(value >> 48)) - 8 * entryAge;
+        //얕고 오래된 항목일수록 교체 우선
+        if (entryValue < replaceValue)
+        {
+            replaceValue = entryValue;
+            replace = &entry;
+        }
+    }
+
+    if (depth > 127)
+    {//깊이는 8비트에 저장하므로 범위를 넘지 않게 자름
+        depth = 127;
+    }
+    else if (depth < -128)
+    {
+        depth = -128;
+    }
+    uint64_t value = uint64_t(move.raw())
+                     | uint64_t(uint16_t(int16_t(score))) << 16
+                     | uint64_t(uint16_t(int16_t(eval))) << 32
+                     | uint64_t(uint8_t(int8_t(depth))) << 48
+                     | uint64_t(bound) << 56
+                     | uint64_t(generation) << 58;
+    replace->check.store(key ^ value, std::memory_order_relaxed);
+    replace->data.store(value, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const
+{
+    int used = 0;
+    size_t sampleBuckets = bucketCount < 250 ? bucketCount : 250;
+    for (size_t i = 0; i < sampleBuckets; ++i)
+    {
+        for (const Entry& entry : buckets[i].entries)
+        {
+            uint64_t value = entry.data.load(std::memory_order_relaxed);
+            if (((value >> 56) & 3) != BoundNone && (value >> 58) == generation)
+            {
+                ++used;
+            }
+        }
+    }
+    return sampleBuckets ? int(used * 1000 / (sampleBuckets * BucketSize)) : 0;
+}
@@ -0,0 +1,86 @@
+#ifndef TT_H
+#define TT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "move.h"
+
+//여러 탐색 스레드가 잠금없이 공유하는 치환표
+//64바이트 캐시라인 하나에 16바이트 항목 4개를 묶어 한번의 메모리 접근으로 검사한다
+
+enum Bound : uint8_t
+{
+    BoundNone,
+    BoundUpper,//점수가 alpha를 넘지 못함
+    BoundLower,//beta 컷오프가 일어남
+    BoundExact = BoundUpper | BoundLower
+};
+
+struct TTData
+//치환표에서 꺼낸 값
+{
+    Move move;
+    int score;
+    int eval;
+    int depth;
+    Bound bound;
+};
+
+class TranspositionTable
+{
+public:
+    TranspositionTable();
+    ~TranspositionTable();
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    bool resize(size_t megabytes);//기존 내용은 지워짐,요청한 크기를 할당하지 못하면 false
+    void clear();
+    void newSearch()//탐색을 시작할때마다 세대를 올려 오래된 항목을 먼저 교체
+    {
+        generation = uint8_t((generation + 1) & 63);
+    }
+
+    bool probe(uint64_t key, TTData& data) const;
+    void store(uint64_t key, int depth, Bound bound, int score, int eval, Move move);
+    int hashfull() const;//앞쪽 1000개 항목 중 이번 탐색에서 기록된 수
+
+    void prefetch(uint64_t key) const//수를 둔 직후 호출해 다음 검사 전에 캐시라인을 가져옴
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(bucketFor(key));
+#endif
+    }
+
+private:
+    struct Entry
+    //check는 key^data,두 스레드가 동시에 기록해 섞이면 검사에서 걸러짐
+    //data: 0~15 수,16~31 점수,32~47 정적 평가,48~55 깊이,56~57 범위,58~63 세대
+    {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    static const int BucketSize = 4;
+    struct alignas(64) Bucket
+    {
+        Entry entries[BucketSize];
+    };
+    static_assert(sizeof(Bucket) == 64, "bucket must fill one cache line");
+
+    Bucket* bucketFor(uint64_t key) const
+    {
+        return buckets + (key & mask);
+    }
+    void release();
+
+    Bucket fallback;//메모리를 전혀 할당하지 못했을때 쓰는 버킷 하나
+    Bucket* buckets = nullptr;
+    size_t bucketCount = 0;
+    size_t mask = 0;
+    size_t allocatedBytes = 0;
+    uint8_t generation = 0;
+};
+
+#endif // TT_H
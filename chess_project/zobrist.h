@@ -0,0 +1,50 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+//국면 식별용 64비트 조브리스트 난수
+//고정 시드로 컴파일 시간에 만들어 실행마다 같은 값을 가진다
+
+struct ZobristKeys
+{
+    uint64_t pieceSquare[12][64];
+    uint64_t side;//흑 차례일때
+    uint64_t castling[16];//캐슬링 권리 조합별
+    uint64_t enPassant[8];//앙파상 칸의 파일별
+};
+
+constexpr ZobristKeys makeZobristKeys()
+{
+    ZobristKeys keys = {};
+    uint64_t seed = 1070372;
+    auto next = [&seed]()
+    {//xorshift64*
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        return seed * 2685821657736338717ULL;
+    };
+
+    for (int piece = 0; piece < 12; ++piece)
+    {
+        for (int sq = 0; sq < 64; ++sq)
+        {
+            keys.pieceSquare[piece][sq] = next();
+        }
+    }
+    keys.side = next();
+    for (int i = 0; i < 16; ++i)
+    {
+        keys.castling[i] = i ? next() : 0;//권리가 없으면 0
+    }
+    for (int file = 0; file < 8; ++file)
+    {
+        keys.enPassant[file] = next();
+    }
+    return keys;
+}
+
+inline constexpr ZobristKeys Zobrist = makeZobristKeys();
+
+#endif // ZOBRIST_H